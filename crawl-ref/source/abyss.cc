@@ -22,6 +22,7 @@
 #include "dbg-scan.h"
 #include "delay.h"
 #include "dgn-overview.h"
+#include "dgnevent.h"
 #include "dgn-proclayouts.h"
 #include "files.h"
 #include "godpassive.h" // passive_t::slow_abyss
@@ -42,6 +43,7 @@
 #include "notes.h"
 #include "output.h" // redraw_screens
 #include "religion.h"
+#include "shopping.h"
 #include "spl-clouds.h" // big_cloud
 #include "stash.h"
 #include "state.h"
@@ -739,12 +741,6 @@ static void _abyss_wipe_unmasked_area(const map_bitmask &abyss_preserve_mask)
             _abyss_wipe_square_at(*ri);
 }
 
-// Moves everything at src to dst.
-static void _abyss_move_entities_at(coord_def src, coord_def dst)
-{
-    dgn_move_entities_at(src, dst, true, true, true);
-}
-
 // Move all vaults within the mask by the specified delta.
 static void _abyss_move_masked_vaults_by_delta(const coord_def delta)
 {
@@ -772,6 +768,10 @@ static void _abyss_move_masked_vaults_by_delta(const coord_def delta)
 // in movement distance) around the player with the given radius to
 // the square centred on target_centre.
 //
+// Everything outside the shift area must already have been wiped. The
+// grids are moved as whole blocks and each entity list is adjusted by the
+// same delta, rather than moving things one square at a time.
+//
 // Assumes:
 // a) target can be truncated if not fully in bounds
 // b) source and target areas may overlap
@@ -779,55 +779,115 @@ static void _abyss_move_masked_vaults_by_delta(const coord_def delta)
 static void _abyss_move_entities(coord_def target_centre,
                                  map_bitmask *shift_area_mask)
 {
-    const coord_def source_centre = you.pos();
-    const coord_def delta = (target_centre - source_centre).sgn();
+    const coord_def delta = target_centre - you.pos();
+    const coord_def tl(MAPGEN_BORDER, MAPGEN_BORDER);
+    const coord_def br(GXM - 1 - MAPGEN_BORDER, GYM - 1 - MAPGEN_BORDER);
 
-    // When moving a region, walk backward to handle overlapping
-    // ranges correctly.
-    coord_def direction = -delta;
+    // Anything that would be moved off the level is destroyed in place.
+    for (rectangle_iterator ri(MAPGEN_BORDER); ri; ++ri)
+    {
+        if (shift_area_mask->get(*ri)
+            && !map_bounds_with_margin(*ri + delta, MAPGEN_BORDER))
+        {
+            _abyss_wipe_square_at(*ri);
+            shift_area_mask->set(*ri, false);
+        }
+    }
+
+    // Bookkeeping keyed by position, which needs the unshifted mask.
+    shift_notable_things(*shift_area_mask, delta);
+    shopping_list.shift_things(delta);
+    StashTrack.shift_stashes(delta);
+
+    map_bitmask shifted_area;
+    map_bitmask seen = env.map_seen;
+    for (rectangle_iterator ri(MAPGEN_BORDER); ri; ++ri)
+    {
+        seen.set(*ri, false);
+        if (shift_area_mask->get(*ri))
+            shifted_area.set(*ri + delta);
+    }
+    for (rectangle_iterator ri(MAPGEN_BORDER); ri; ++ri)
+        if (shift_area_mask->get(*ri))
+            seen.set(*ri + delta, env.map_seen(*ri));
+    *shift_area_mask = shifted_area;
+    env.map_seen = seen;
+
+    // Terrain, properties, colours, vault masks and map knowledge.
+    shift_grid_rect(env.grid, tl, br, delta, DNGN_UNSEEN);
+    shift_grid_rect(env.pgrid, tl, br, delta, terrain_property_t(0));
+    shift_grid_rect(env.mgrid, tl, br, delta, NON_MONSTER);
+    shift_grid_rect(env.igrid, tl, br, delta, NON_ITEM);
+    shift_grid_rect(env.grid_colours, tl, br, delta, 0);
+#ifdef USE_TILE
+    shift_grid_rect(env.tile_bk_fg, tl, br, delta, 0);
+    shift_grid_rect(env.tile_bk_bg, tl, br, delta, 0);
+    shift_grid_rect(env.tile_bk_cloud, tl, br, delta, 0);
+#endif
+    shift_grid_rect(env.tile_flv, tl, br, delta, tile_flavour());
+    shift_grid_rect(env.level_map_mask, tl, br, delta, 0);
+    shift_grid_rect(env.level_map_ids, tl, br, delta, INVALID_MAP_INDEX);
+    shift_grid_rect(env.map_knowledge, tl, br, delta, map_cell());
+    dungeon_events.shift_listeners(tl, br, delta);
 
-    if (!direction.x)
-        direction.x = 1;
-    if (!direction.y)
-        direction.y = 1;
+    // Shops and traps.
+    map<coord_def, shop_struct> shops;
+    for (auto &entry : env.shop)
+    {
+        entry.second.pos += delta;
+        shops.emplace(entry.second.pos, move(entry.second));
+    }
+    env.shop.swap(shops);
 
-    coord_def start(MAPGEN_BORDER, MAPGEN_BORDER);
-    coord_def end(GXM - 1 - MAPGEN_BORDER, GYM - 1 - MAPGEN_BORDER);
+    map<coord_def, trap_def> traps;
+    for (auto &entry : env.trap)
+    {
+        entry.second.pos += delta;
+        traps.emplace(entry.second.pos, move(entry.second));
+    }
+    env.trap.swap(traps);
 
-    if (direction.x == -1)
-        swap(start.x, end.x);
-    if (direction.y == -1)
-        swap(start.y, end.y);
+    // Clouds.
+    env.cloud.shift(delta);
 
-    end += direction;
+    // Markers.
+    for (map_marker *marker : env.markers.get_all())
+        if (map_bounds_with_margin(marker->pos, MAPGEN_BORDER))
+            env.markers.move_marker(marker, marker->pos + delta);
 
-    for (int y = start.y; y != end.y; y += direction.y)
+    // Items on the floor; their stacks moved with igrid.
+    for (int i = 0; i < MAX_ITEMS; ++i)
     {
-        for (int x = start.x; x != end.x; x += direction.x)
+        item_def &item(mitm[i]);
+        if (item.defined() && in_bounds(item.pos)
+            && !item.held_by_monster())
         {
-            const coord_def src(x, y);
-            if (!shift_area_mask->get(src))
-                continue;
+            item.pos += delta;
+        }
+    }
 
-            shift_area_mask->set(src, false);
+    // Monsters, and finally the player.
+    for (monster_iterator mi; mi; ++mi)
+    {
+        if (!in_bounds(mi->pos()))
+            continue;
 
-            const coord_def dst = src - source_centre + target_centre;
-            if (map_bounds_with_margin(dst, MAPGEN_BORDER))
-            {
-                shift_area_mask->set(dst);
-                // Wipe the dstination clean before dropping things on it.
-                _abyss_wipe_square_at(dst);
-                _abyss_move_entities_at(src, dst);
-            }
-            else
-            {
-                // Wipe the source clean even if the dst is not in bounds.
-                _abyss_wipe_square_at(src);
-            }
+        if (mi->is_projectile())
+        {
+            mi->props[IOOD_X].get_float() += delta.x;
+            mi->props[IOOD_Y].get_float() += delta.y;
+        }
+        if (mi->type == MONS_ELDRITCH_TENTACLE
+            && mi->props.exists("base_position"))
+        {
+            mi->props["base_position"].get_coord() += delta;
         }
+        mi->set_position(mi->pos() + delta);
     }
 
-    _abyss_move_masked_vaults_by_delta(target_centre - source_centre);
+    you.shiftto(you.pos() + delta);
+
+    _abyss_move_masked_vaults_by_delta(delta);
 }
 
 static void _abyss_expand_mask_to_cover_vault(map_bitmask *mask,
@@ -100,6 +100,16 @@ public:
         return *this;
     }
 
+    inline bool operator==(const FixedBitVector<SIZE>&x) const
+    {
+        return data == x.data;
+    }
+
+    inline bool operator!=(const FixedBitVector<SIZE>&x) const
+    {
+        return data != x.data;
+    }
+
     void init(bool value)
     {
         data.reset();
@@ -36,7 +36,7 @@
 
 cloud_struct* cloud_at(coord_def pos)
 {
-    return map_find(env.cloud, pos);
+    return env.cloud.find(pos);
 }
 
 /// A portrait of a cloud_type.
@@ -284,7 +284,98 @@ cloud_struct::cloud_struct(coord_def p, cloud_type c, int d, int spread,
     _los_cloud_changed(pos, type);
 }
 
-static int _spread_cloud(const cloud_struct &cloud)
+cloud_list::cloud_list()
+{
+    index.init(-1);
+}
+
+cloud_struct *cloud_list::find(const coord_def &pos)
+{
+    const int i = index(pos);
+    return i == -1 ? nullptr : &clouds[i];
+}
+
+const cloud_struct *cloud_list::find(const coord_def &pos) const
+{
+    const int i = index(pos);
+    return i == -1 ? nullptr : &clouds[i];
+}
+
+cloud_struct &cloud_list::set(const coord_def &pos, const cloud_struct &cloud)
+{
+    int &i = index(pos);
+    if (i == -1)
+    {
+        i = clouds.size();
+        clouds.push_back(cloud);
+    }
+    else
+        clouds[i] = cloud;
+
+    clouds[i].pos = pos;
+    return clouds[i];
+}
+
+void cloud_list::erase(const coord_def &pos)
+{
+    const int i = index(pos);
+    if (i == -1)
+        return;
+
+    index(pos) = -1;
+    if (i != (int) clouds.size() - 1)
+    {
+        clouds[i] = std::move(clouds.back());
+        index(clouds[i].pos) = i;
+    }
+    clouds.pop_back();
+}
+
+void cloud_list::move(const coord_def &src, const coord_def &dst)
+{
+    const int i = index(src);
+    if (i == -1 || src == dst)
+        return;
+
+    erase(dst);
+    // The erase may have moved our cloud into the freed slot.
+    const int j = index(src);
+    index(src) = -1;
+    index(dst) = j;
+    clouds[j].pos = dst;
+}
+
+void cloud_list::swap(const coord_def &p1, const coord_def &p2)
+{
+    int &i1 = index(p1);
+    int &i2 = index(p2);
+    std::swap(i1, i2);
+    if (i1 != -1)
+        clouds[i1].pos = p1;
+    if (i2 != -1)
+        clouds[i2].pos = p2;
+}
+
+void cloud_list::shift(const coord_def &delta)
+{
+    for (const cloud_struct &cloud : clouds)
+        index(cloud.pos) = -1;
+    for (unsigned int i = 0; i < clouds.size(); ++i)
+    {
+        clouds[i].pos += delta;
+        index(clouds[i].pos) = i;
+    }
+}
+
+void cloud_list::clear()
+{
+    for (const cloud_struct &cloud : clouds)
+        index(cloud.pos) = -1;
+    clouds.clear();
+}
+
+// Takes the cloud by value, since spreading adds to the cloud list.
+static int _spread_cloud(const cloud_struct cloud)
 {
     const int spreadch = cloud.decay > 30 ? 80 :
                          cloud.decay > 20 ? 50 :
@@ -310,9 +401,7 @@ static int _spread_cloud(const cloud_struct &cloud)
         if (newdecay >= cloud.decay)
             newdecay = cloud.decay - 1;
 
-        env.cloud[*ai] = cloud;
-        env.cloud[*ai].pos = *ai;
-        env.cloud[*ai].decay = newdecay;
+        env.cloud.set(*ai, cloud).decay = newdecay;
 
         extra_decay += 8;
     }
@@ -320,7 +409,7 @@ static int _spread_cloud(const cloud_struct &cloud)
     return extra_decay;
 }
 
-static void _spread_fire(const cloud_struct &cloud)
+static void _spread_fire(const cloud_struct cloud)
 {
     int make_flames = one_chance_in(5);
 
@@ -336,10 +425,9 @@ static void _spread_fire(const cloud_struct &cloud)
         // burning trees produce flames all around
         if (!cell_is_solid(*ai) && make_flames)
         {
-            env.cloud[*ai] = cloud;
-            env.cloud[*ai].type = CLOUD_FIRE;
-            env.cloud[*ai].pos = *ai;
-            env.cloud[*ai].decay = cloud.decay / 2 + 1;
+            cloud_struct &flames = env.cloud.set(*ai, cloud);
+            flames.type = CLOUD_FIRE;
+            flames.decay = cloud.decay / 2 + 1;
         }
 
         // forest fire doesn't spread in all directions at once,
@@ -353,9 +441,7 @@ static void _spread_fire(const cloud_struct &cloud)
         if (you.see_cell(*ai))
             mpr("The forest fire spreads!");
         destroy_wall(*ai);
-        env.cloud[*ai] = cloud;
-        env.cloud[*ai].pos = *ai;
-        env.cloud[*ai].decay = random2(30) + 25;
+        env.cloud.set(*ai, cloud).decay = random2(30) + 25;
         if (cloud.whose == KC_YOU)
         {
             did_god_conduct(DID_KILL_PLANT, 1);
@@ -367,7 +453,7 @@ static void _spread_fire(const cloud_struct &cloud)
     }
 }
 
-static void _cloud_interacts_with_terrain(const cloud_struct &cloud)
+static void _cloud_interacts_with_terrain(const cloud_struct cloud)
 {
     if (cloud.type != CLOUD_FIRE && cloud.type != CLOUD_FOREST_FIRE)
         return;
@@ -381,9 +467,9 @@ static void _cloud_interacts_with_terrain(const cloud_struct &cloud)
             && !cloud_at(p)
             && one_chance_in(7))
         {
-            env.cloud[p] = cloud_struct(p, CLOUD_STEAM, cloud.decay / 2 + 1,
-                                        22, cloud.whose, cloud.killer,
-                                        cloud.source, -1, "", "", -1);
+            env.cloud.set(p, cloud_struct(p, CLOUD_STEAM, cloud.decay / 2 + 1,
+                                          22, cloud.whose, cloud.killer,
+                                          cloud.source, -1, "", "", -1));
         }
     }
 }
@@ -430,25 +516,27 @@ static int _cloud_dissipation_rate(const cloud_struct &cloud)
     return dissipate;
 }
 
-static void _dissipate_cloud(cloud_struct& cloud)
+static void _dissipate_cloud(const coord_def pos)
 {
     // Apply calculated rate to the actual cloud.
-    cloud.decay -= _cloud_dissipation_rate(cloud);
+    cloud_struct *cloud = cloud_at(pos);
+    cloud->decay -= _cloud_dissipation_rate(*cloud);
 
-    if (cloud.type == CLOUD_FOREST_FIRE)
-        _spread_fire(cloud);
-    else if (x_chance_in_y(cloud.spread_rate, 100))
+    if (cloud->type == CLOUD_FOREST_FIRE)
+        _spread_fire(*cloud);
+    else if (x_chance_in_y(cloud->spread_rate, 100))
     {
-        cloud.spread_rate -= div_rand_round(cloud.spread_rate, 10);
-        cloud.decay       -= _spread_cloud(cloud);
+        cloud->spread_rate -= div_rand_round(cloud->spread_rate, 10);
+        const int spread_decay = _spread_cloud(*cloud);
+        cloud_at(pos)->decay -= spread_decay;
     }
 
     // Check for total dissipation and handle accordingly.
-    if (cloud.decay < 1)
-        delete_cloud(cloud.pos);
+    if (cloud_at(pos)->decay < 1)
+        delete_cloud(pos);
 }
 
-static void _handle_spectral_cloud(const cloud_struct& cloud)
+static void _handle_spectral_cloud(const cloud_struct cloud)
 {
     if (actor_at(cloud.pos) || !actor_by_mid(cloud.source))
         return;
@@ -487,15 +575,19 @@ static void _handle_spectral_cloud(const cloud_struct& cloud)
 
 void manage_clouds()
 {
-    // We can't iterate over env.cloud directly because _dissipate_cloud
-    // will remove this cloud and invalidate our iterator.
-    vector<cloud_struct *> cloud_ptrs;
-    for (auto& entry : env.cloud)
-        cloud_ptrs.push_back(&entry.second);
+    // We can't iterate over env.cloud directly, since clouds spreading or
+    // dissipating reorder the list. Handle the clouds that exist now, in
+    // position order.
+    vector<coord_def> cloud_locs;
+    for (const cloud_struct &cloud : env.cloud)
+        cloud_locs.push_back(cloud.pos);
+    sort(cloud_locs.begin(), cloud_locs.end());
 
-    for (auto ptr : cloud_ptrs)
+    for (const coord_def pos : cloud_locs)
     {
-        cloud_struct& cloud = *ptr;
+        if (!cloud_at(pos))
+            continue;
+        const cloud_struct& cloud = *cloud_at(pos);
 
 #ifdef ASSERTS
         if (cell_is_solid(cloud.pos))
@@ -519,9 +611,9 @@ void manage_clouds()
         else if (cloud.type == CLOUD_SPECTRAL)
             _handle_spectral_cloud(cloud);
 
-        _cloud_interacts_with_terrain(cloud);
+        _cloud_interacts_with_terrain(*cloud_at(pos));
 
-        _dissipate_cloud(cloud);
+        _dissipate_cloud(pos);
     }
 }
 
@@ -575,8 +667,8 @@ void delete_all_clouds()
     // We can't iterate over env.cloud directly because delete_cloud
     // will remove this cloud and invalidate our iterator.
     vector<coord_def> cloud_locs;
-    for (auto& entry : env.cloud)
-        cloud_locs.push_back(entry.first);
+    for (const cloud_struct &cloud : env.cloud)
+        cloud_locs.push_back(cloud.pos);
 
     for (auto pos : cloud_locs)
         delete_cloud(pos);
@@ -590,11 +682,9 @@ void move_cloud(coord_def src, coord_def newpos)
         return;
     ASSERT(!cell_is_solid(newpos));
 
-    env.cloud[newpos] = env.cloud[src];
-    env.cloud.erase(src);
-    env.cloud[newpos].pos = newpos;
-    _los_cloud_changed(src, env.cloud[newpos].type);
-    _los_cloud_changed(newpos, env.cloud[newpos].type);
+    env.cloud.move(src, newpos);
+    _los_cloud_changed(src, cloud_at(newpos)->type);
+    _los_cloud_changed(newpos, cloud_at(newpos)->type);
 }
 
 void swap_clouds(coord_def p1, coord_def p2)
@@ -612,11 +702,7 @@ void swap_clouds(coord_def p1, coord_def p2)
         return;
     }
 
-    cloud_struct temp = env.cloud[p1];
-    env.cloud[p1] = env.cloud[p2];
-    env.cloud[p2] = temp;
-    env.cloud[p1].pos = p1;
-    env.cloud[p2].pos = p2;
+    env.cloud.swap(p1, p2);
     if (is_opaque_cloud(cloud_type_at(p1))
         || is_opaque_cloud(cloud_type_at(p2)))
     {
@@ -683,9 +769,9 @@ void place_cloud(cloud_type cl_type, const coord_def& ctarget, int cl_range,
 
     const int spread_rate = _actual_spread_rate(cl_type, _spread_rate);
 
-    env.cloud[ctarget] = cloud_struct(ctarget, cl_type, cl_range * 10,
-                                      spread_rate, whose, killer, source,
-                                      colour, name, tile, excl_rad);
+    env.cloud.set(ctarget, cloud_struct(ctarget, cl_type, cl_range * 10,
+                                        spread_rate, whose, killer, source,
+                                        colour, name, tile, excl_rad));
 }
 
 bool is_opaque_cloud(cloud_type ctype)
@@ -1655,9 +1741,13 @@ void remove_tornado_clouds(mid_t whose)
     // example, this approach doesn't work if we ever make Tornado a monster
     // spell (excluding immobile and mindless casters).
 
-    for (auto& entry : env.cloud)
-        if (entry.second.type == CLOUD_TORNADO && entry.second.source == whose)
-            delete_cloud(entry.first);
+    vector<coord_def> tornado_locs;
+    for (const cloud_struct &cloud : env.cloud)
+        if (cloud.type == CLOUD_TORNADO && cloud.source == whose)
+            tornado_locs.push_back(cloud.pos);
+
+    for (auto pos : tornado_locs)
+        delete_cloud(pos);
 }
 
 static void _spread_cloud(coord_def pos, cloud_type type, int radius, int pow,
@@ -1,6 +1,9 @@
 #ifndef COORD_H
 #define COORD_H
 
+#include <algorithm>
+#include <cstdlib>
+
 coord_def random_in_bounds();
 
 static inline bool in_bounds_x(int x)
@@ -64,6 +67,46 @@ coord_def rotate_adjacent(coord_def vector, int direction) PURE;
 
 coord_def clamp_in_bounds(const coord_def &p) PURE;
 
+// Moves the contents of the rectangle from tl to br (inclusive) of a grid
+// by delta. Anything moved out of the rectangle is discarded, and cells
+// that nothing moves into are set to blank. Grid columns are contiguous,
+// so each column is moved as a single block.
+template <typename Grid, typename Blank>
+void shift_grid_rect(Grid &grid, const coord_def &tl, const coord_def &br,
+                     const coord_def &delta, const Blank &blank)
+{
+    const int height = br.y - tl.y + 1;
+    const int width = br.x - tl.x + 1;
+    const int dy = delta.y;
+
+    // Work against the direction of movement, so that no column is
+    // overwritten before it has been moved.
+    const int step = delta.x > 0 ? -1 : 1;
+    int x = delta.x > 0 ? br.x : tl.x;
+    for (int i = 0; i < width; ++i, x += step)
+    {
+        auto *dst = &grid[x][tl.y];
+        const int sx = x - delta.x;
+        if (sx < tl.x || sx > br.x || abs(dy) >= height)
+        {
+            fill(dst, dst + height, blank);
+            continue;
+        }
+
+        auto *src = &grid[sx][tl.y];
+        if (dy >= 0)
+        {
+            move_backward(src, src + height - dy, dst + height);
+            fill(dst, dst + dy, blank);
+        }
+        else
+        {
+            move(src - dy, src + height, dst);
+            fill(dst + height + dy, dst + height, blank);
+        }
+    }
+}
+
 #ifdef ASSERTS
 #  define ASSERT_IN_BOUNDS(where)                                           \
      ASSERTM(in_bounds(where), "%s = (%d,%d)", #where, (where).x, (where).y)
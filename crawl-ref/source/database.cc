@@ -7,10 +7,12 @@
 
 #include "database.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unordered_map>
 #ifndef TARGET_COMPILER_VC
 #include <unistd.h>
 #endif
@@ -40,6 +42,14 @@ public:
     void shutdown(bool recursive = false);
     DBM* get() { return _db; }
 
+    // Also index the bodies for find_bodies(); must be set before init().
+    void index_bodies() { _index_bodies = true; }
+
+    vector<string> find_keys(const string &regex, bool ignore_case,
+                             db_find_filter filter = nullptr) const;
+    vector<string> find_bodies(const string &regex, bool ignore_case,
+                               db_find_filter filter = nullptr) const;
+
     // Make it easier to migrate from raw DBM* to TextDB
     operator bool() const { return _db != 0; }
     operator DBM*() const { return _db; }
@@ -47,6 +57,7 @@ public:
  private:
     bool _needs_update() const;
     void _regenerate_db();
+    void _build_index();
 
  private:
     bool open_db();
@@ -57,6 +68,15 @@ public:
     string timestamp;
     TextDB *_parent;
     const char* lang() { return _parent ? Options.lang_name : 0; }
+
+    // Every key, in the order the db iterates them.
+    vector<string> _keys;
+    // Lowercased keys with their place in _keys, sorted for prefix searches.
+    vector<pair<string, unsigned int>> _sorted_keys;
+    // For each trigram of the lowercased bodies, the (ascending) places in
+    // _keys of the entries containing it.
+    unordered_map<uint32_t, vector<unsigned int>> _body_trigrams;
+    bool _index_bodies;
 public:
     TextDB *translation;
 };
@@ -165,7 +185,8 @@ static string _db_cache_path(string db, const char *lang)
 
 TextDB::TextDB(const char* db_name, const char* dir, ...)
     : _db_name(db_name), _directory(dir),
-      _db(nullptr), timestamp(""), _parent(0), translation(0)
+      _db(nullptr), timestamp(""), _parent(0), _index_bodies(false),
+      translation(0)
 {
     va_list args;
     va_start(args, dir);
@@ -187,7 +208,8 @@ TextDB::TextDB(TextDB *parent)
     : _db_name(parent->_db_name),
       _directory(parent->_directory + Options.lang_name + "/"),
       _input_files(parent->_input_files), // FIXME: pointless copy
-      _db(nullptr), timestamp(""), _parent(parent), translation(nullptr)
+      _db(nullptr), timestamp(""), _parent(parent),
+      _index_bodies(parent->_index_bodies), translation(nullptr)
 {
 }
 
@@ -214,19 +236,29 @@ void TextDB::init()
     {
         translation = new TextDB(this);
         translation->init();
+        // Translations without any files delete themselves.
+        if (translation)
+            translation->_build_index();
     }
 
     open_db();
 
-    if (!_needs_update())
-        return;
-    _regenerate_db();
-
-    if (!open_db())
+    // _needs_update() may delete a translation, so don't look at members
+    // afterwards unless this is the original.
+    const bool is_translation = _parent;
+    if (_needs_update())
     {
-        end(1, true, "Failed to open DB: %s",
-            _db_cache_path(_db_name, lang()).c_str());
+        _regenerate_db();
+
+        if (!open_db())
+        {
+            end(1, true, "Failed to open DB: %s",
+                _db_cache_path(_db_name, lang()).c_str());
+        }
     }
+
+    if (!is_translation)
+        _build_index();
 }
 
 void TextDB::shutdown(bool recursive)
@@ -236,6 +268,9 @@ void TextDB::shutdown(bool recursive)
         dbm_close(_db);
         _db = nullptr;
     }
+    _keys.clear();
+    _sorted_keys.clear();
+    _body_trigrams.clear();
     if (recursive && translation)
         translation->shutdown(recursive);
 }
@@ -327,6 +362,48 @@ void TextDB::_regenerate_db()
     _db = 0;
 }
 
+// Add the distinct trigrams of s to trigrams, leaving it sorted.
+static void _add_trigrams(vector<uint32_t> &trigrams, const string &s)
+{
+    for (size_t i = 0; i + 2 < s.size(); ++i)
+    {
+        trigrams.push_back((uint8_t) s[i] << 16 | (uint8_t) s[i + 1] << 8
+                           | (uint8_t) s[i + 2]);
+    }
+    sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+// Read every key, and the bodies if wanted, into the tables find_keys()
+// and find_bodies() use to avoid iterating over the whole db.
+void TextDB::_build_index()
+{
+    _keys.clear();
+    _sorted_keys.clear();
+    _body_trigrams.clear();
+
+    for (datum dbKey = dbm_firstkey(_db); dbKey.dptr != nullptr;
+         dbKey = dbm_nextkey(_db))
+    {
+        const unsigned int index = _keys.size();
+        _keys.emplace_back((const char *)dbKey.dptr, dbKey.dsize);
+        _sorted_keys.emplace_back(lowercase_string(_keys.back()), index);
+
+        if (!_index_bodies)
+            continue;
+
+        datum dbBody = dbm_fetch(_db, dbKey);
+        vector<uint32_t> trigrams;
+        _add_trigrams(trigrams, lowercase_string(
+                                    string((const char *)dbBody.dptr,
+                                           dbBody.dsize)));
+        for (uint32_t trigram : trigrams)
+            _body_trigrams[trigram].push_back(index);
+    }
+
+    sort(_sorted_keys.begin(), _sorted_keys.end());
+}
+
 // ----------------------------------------------------------------------
 // DB system
 // ----------------------------------------------------------------------
@@ -343,10 +420,15 @@ static void* init_db(void *arg)
 
 void databaseSystemInit()
 {
+#ifdef USE_SQLITE_DBM
     // Note: if you're building contrib libraries initially checked out
     // before 2011-12-28 and this assertion fails, please make sure you have
     // the current version ("git submodule sync;git submodule update --init").
     ASSERT(sqlite3_threadsafe());
+#endif
+
+    // Lookup help searches the descriptions by regex.
+    DescriptionDB.index_bodies();
 
     thread_t th[NUM_DB];
     for (unsigned int i = 0; i < NUM_DB; i++)
@@ -392,19 +474,128 @@ static datum _database_fetch(DBM *database, const string &key)
     return result;
 }
 
-static vector<string> _database_find_keys(DBM *database,
-                                          const string &regex,
-                                          bool ignore_case,
-                                          db_find_filter filter = nullptr)
+/**
+ * Find strings that every match of a regular expression has to contain.
+ *
+ * This only understands enough of the syntax to be sure of what it finds;
+ * anything inside groups is ignored, and alternations, inline options or
+ * bracketed character classes give up altogether.
+ *
+ * @param regex         The (extended or PCRE) regular expression.
+ * @param[out] prefix   Set to the literal text a match has to start with,
+ *                      if the expression is anchored; otherwise left alone.
+ * @return              The literal runs outside groups, lowercased.
+ */
+static vector<string> _regex_literals(const string &regex, string &prefix)
+{
+    vector<string> literals;
+    if (regex.find('|') != string::npos || regex.find("(?") != string::npos
+        || regex.find("[:") != string::npos
+        || regex.find("[.") != string::npos
+        || regex.find("[=") != string::npos)
+    {
+        return literals;
+    }
+
+    string run;
+    int depth = 0;
+    bool anchored = !regex.empty() && regex[0] == '^';
+    auto end_run = [&]()
+    {
+        if (depth == 0 && !run.empty())
+        {
+            if (anchored)
+                prefix = lowercase_string(run);
+            literals.push_back(lowercase_string(run));
+        }
+        run.clear();
+        anchored = false;
+    };
+
+    for (size_t i = anchored ? 1 : 0; i < regex.size(); ++i)
+    {
+        const char c = regex[i];
+        switch (c)
+        {
+        case '?': case '*': case '{':
+            // The last character might not be there at all.
+            if (!run.empty())
+                run.erase(run.size() - 1);
+            end_run();
+            if (c == '{')
+            {
+                i = regex.find('}', i);
+                if (i == string::npos)
+                    return vector<string>();
+            }
+            break;
+        case '(':
+            end_run();
+            ++depth;
+            break;
+        case ')':
+            end_run();
+            --depth;
+            break;
+        case '[':
+            end_run();
+            // A ']' straight after the opening (or its negation) is literal.
+            i = regex.find(']', regex[i + 1] == '^' ? i + 3 : i + 2);
+            if (i == string::npos)
+                return vector<string>();
+            break;
+        case '\\':
+            if (i + 1 == regex.size() || isaalnum(regex[i + 1])
+                || regex[i + 1] & 0x80)
+            {
+                end_run();
+                ++i;
+            }
+            else
+                run += regex[++i];
+            break;
+        case '+': case '.': case '^': case '$':
+            end_run();
+            break;
+        default:
+            if (c & 0x80)
+                end_run();
+            else
+                run += c;
+        }
+    }
+    end_run();
+
+    return literals;
+}
+
+vector<string> TextDB::find_keys(const string &regex, bool ignore_case,
+                                 db_find_filter filter) const
 {
     text_pattern             tpat(regex, ignore_case);
     vector<string> matches;
 
-    datum dbKey = dbm_firstkey(database);
+    // Only keys starting with the anchored text, if there is any, can match.
+    string prefix;
+    _regex_literals(regex, prefix);
+    auto first = _sorted_keys.begin();
+    auto last = _sorted_keys.end();
+    if (!prefix.empty())
+    {
+        first = lower_bound(first, last, make_pair(prefix, 0u));
+        last = first;
+        while (last != _sorted_keys.end() && starts_with(last->first, prefix))
+            ++last;
+    }
+
+    vector<unsigned int> candidates;
+    for (auto i = first; i != last; ++i)
+        candidates.push_back(i->second);
+    sort(candidates.begin(), candidates.end());
 
-    while (dbKey.dptr != nullptr)
+    for (unsigned int index : candidates)
     {
-        string key((const char *)dbKey.dptr, dbKey.dsize);
+        const string &key = _keys[index];
 
         if (tpat.matches(key)
             && key.find("__") == string::npos
@@ -412,38 +603,65 @@ static vector<string> _database_find_keys(DBM *database,
         {
             matches.push_back(key);
         }
-
-        dbKey = dbm_nextkey(database);
     }
 
     return matches;
 }
 
-static vector<string> _database_find_bodies(DBM *database,
-                                            const string &regex,
-                                            bool ignore_case,
-                                            db_find_filter filter = nullptr)
+vector<string> TextDB::find_bodies(const string &regex, bool ignore_case,
+                                   db_find_filter filter) const
 {
+    ASSERT(_index_bodies);
     text_pattern             tpat(regex, ignore_case);
     vector<string> matches;
 
-    datum dbKey = dbm_firstkey(database);
+    // Only entries containing every trigram of the text a match needs can
+    // match; intersect their lists.
+    string prefix;
+    vector<uint32_t> trigrams;
+    for (const string &literal : _regex_literals(regex, prefix))
+        _add_trigrams(trigrams, literal);
 
-    while (dbKey.dptr != nullptr)
+    vector<unsigned int> candidates;
+    if (trigrams.empty())
+    {
+        for (unsigned int index = 0; index < _keys.size(); ++index)
+            candidates.push_back(index);
+    }
+    for (size_t i = 0; i < trigrams.size(); ++i)
     {
-        string key((const char *)dbKey.dptr, dbKey.dsize);
+        auto posting = _body_trigrams.find(trigrams[i]);
+        if (posting == _body_trigrams.end())
+            return matches;
 
-        datum dbBody = dbm_fetch(database, dbKey);
+        if (i == 0)
+            candidates = posting->second;
+        else
+        {
+            vector<unsigned int> both;
+            set_intersection(candidates.begin(), candidates.end(),
+                             posting->second.begin(), posting->second.end(),
+                             back_inserter(both));
+            candidates.swap(both);
+        }
+        if (candidates.empty())
+            return matches;
+    }
+
+    for (unsigned int index : candidates)
+    {
+        const string &key = _keys[index];
+        if (key.find("__") != string::npos)
+            continue;
+
+        datum dbBody = _database_fetch(_db, key);
         string body((const char *)dbBody.dptr, dbBody.dsize);
 
         if (tpat.matches(body)
-            && key.find("__") == string::npos
             && (filter == nullptr || !(*filter)(key, body)))
         {
             matches.push_back(key);
         }
-
-        dbKey = dbm_nextkey(database);
     }
 
     return matches;
@@ -795,7 +1013,7 @@ vector<string> getLongDescKeysByRegex(const string &regex,
 
     // FIXME: need to match regex against translated keys, which can't
     // be done by db only.
-    return _database_find_keys(DescriptionDB.get(), regex, true, filter);
+    return DescriptionDB.find_keys(regex, true, filter);
 }
 
 vector<string> getLongDescBodiesByRegex(const string &regex,
@@ -811,9 +1029,9 @@ vector<string> getLongDescBodiesByRegex(const string &regex,
     // Not good, but otherwise we'd have to check hundreds of keys, with
     // two queries for each.
     // SQL can do this in one go, DBM can't.
-    DBM *database = DescriptionDB.translation ?
-        DescriptionDB.translation->get() : DescriptionDB.get();
-    return _database_find_bodies(database, regex, true, filter);
+    const TextDB &database = DescriptionDB.translation ?
+        *DescriptionDB.translation : DescriptionDB;
+    return database.find_bodies(regex, true, filter);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -877,7 +1095,7 @@ vector<string> getAllFAQKeys()
         return empty;
     }
 
-    return _database_find_keys(FAQDB.get(), "^q.+", false);
+    return FAQDB.find_keys("^q.+", false);
 }
 
 string getFAQ_Question(const string &key)
@@ -19,6 +19,8 @@ extern "C" {
 }
 #elif defined(USE_SQLITE_DBM)
 #   include "sqldbm.h"
+#elif defined(USE_MAPPED_DBM)
+#   include "mapdbm.h"
 #else
 #   error DBM interfaces unavailable!
 #endif
@@ -14,6 +14,8 @@
 #include "dungeon.h"
 #include "env.h"
 #include "initfile.h"
+#include "json.h"
+#include "json-wrapper.h"
 #include "libutil.h"
 #include "maps.h"
 #include "message.h"
@@ -22,6 +24,7 @@
 #include "shopping.h"
 #include "state.h"
 #include "stringutil.h"
+#include "version.h"
 #include "view.h"
 
 #ifdef DEBUG_STATISTICS
@@ -30,6 +33,7 @@
 static map<string, int> try_count;
 static map<string, int> use_count;
 static map<string, int> success_count;
+static map<string, pair<int, chrono::microseconds>> lua_time;
 static vector<level_id> generated_levels;
 static int branch_count;
 static map<level_id, int> level_mapcounts;
@@ -46,6 +50,28 @@ static int build_attempts = 0, level_vetoes = 0;
 // Map from message to counts.
 static map<string, int> veto_messages;
 
+// Level generation timings for -genbench.
+struct gen_timing
+{
+    int builds = 0, failures = 0, attempts = 0, vetoes = 0;
+    chrono::microseconds time = chrono::microseconds::zero();
+
+    void add(const gen_timing &other)
+    {
+        builds   += other.builds;
+        failures += other.failures;
+        attempts += other.attempts;
+        vetoes   += other.vetoes;
+        time     += other.time;
+    }
+
+    double levels_per_sec() const
+    {
+        return time.count() ? builds * 1000000.0 / time.count() : 0.0;
+    }
+};
+static map<level_id, gen_timing> level_timings;
+
 void mapstat_report_map_build_start()
 {
     build_attempts++;
@@ -92,8 +118,15 @@ static bool _do_build_level()
     }
 
     ++levels_tried;
-    if (!builder())
+    const auto build_start = chrono::steady_clock::now();
+    const bool built = builder();
+    gen_timing &timing = level_timings[level_id::current()];
+    timing.builds++;
+    timing.time += chrono::duration_cast<chrono::microseconds>(
+                       chrono::steady_clock::now() - build_start);
+    if (!built)
     {
+        timing.failures++;
         ++levels_failed;
         // Abort level build failure in objstat since the statistics will be
         // off.
@@ -293,6 +326,14 @@ void mapstat_report_error(const map_def &map, const string &err)
     last_error = err;
 }
 
+void mapstat_report_map_lua_time(const map_def &map,
+                                 chrono::microseconds elapsed)
+{
+    auto &entry = lua_time[map.name];
+    entry.first++;
+    entry.second += elapsed;
+}
+
 static void _report_available_random_vaults(FILE *outf)
 {
     you.uniq_map_tags.clear();
@@ -452,6 +493,22 @@ static void _write_map_stats()
                 succ, uses, tries, entry.second.c_str());
     }
 
+    if (!lua_time.empty())
+    {
+        fprintf(outf, "\n\nMap Lua time (total ms, runs, avg us):\n\n");
+        multimap<chrono::microseconds, string> sortedtimes;
+        for (const auto &entry : lua_time)
+            sortedtimes.insert(make_pair(entry.second.second, entry.first));
+
+        for (auto i = sortedtimes.rbegin(); i != sortedtimes.rend(); ++i)
+        {
+            const int runs = lua_time[i->second].first;
+            fprintf(outf, "%8.1f, %5d, %8.1f: %s\n",
+                    i->first.count() / 1000.0, runs,
+                    i->first.count() / (double) runs, i->second.c_str());
+        }
+    }
+
     fprintf(outf, "\n\nMaps and where used:\n\n");
     for (const auto &entry : map_levelsused)
     {
@@ -479,6 +536,138 @@ static void _write_map_stats()
     printf("\n");
 }
 
+static JsonNode *_timing_json(const gen_timing &timing)
+{
+    JsonNode *entry(json_mkobject());
+    json_append_member(entry, "builds", json_mknumber(timing.builds));
+    json_append_member(entry, "failures", json_mknumber(timing.failures));
+    json_append_member(entry, "attempts", json_mknumber(timing.attempts));
+    json_append_member(entry, "vetoes", json_mknumber(timing.vetoes));
+    json_append_member(entry, "ms",
+                       json_mknumber(timing.time.count() / 1000.0));
+    json_append_member(entry, "levels_per_sec",
+                       json_mknumber(timing.levels_per_sec()));
+    return entry;
+}
+
+static double _levels_per_sec(JsonNode *entry)
+{
+    JsonNode *lps = entry ? json_find_member(entry, "levels_per_sec")
+                          : nullptr;
+    return lps && lps->tag == JSON_NUMBER ? lps->number_ : 0.0;
+}
+
+static void _compare_line(const string &place, JsonNode *old_entry,
+                          JsonNode *new_entry)
+{
+    const double old_lps = _levels_per_sec(old_entry);
+    const double new_lps = _levels_per_sec(new_entry);
+    if (!old_lps || !new_lps)
+        return;
+
+    const double change = (new_lps - old_lps) * 100.0 / old_lps;
+    printf("%-12s %10.2f %10.2f %+8.1f%%%s\n", place.c_str(), old_lps,
+           new_lps, change, change <= -10.0 ? "  SLOWER" : "");
+}
+
+// Prints levels per second against those in an earlier genbench.json.
+static void _compare_with_baseline(JsonNode *results, const string &file)
+{
+    FILE *inf = fopen(file.c_str(), "r");
+    if (!inf)
+    {
+        fprintf(stderr, "Unable to open genbench baseline %s: %s\n",
+                file.c_str(), strerror(errno));
+        return;
+    }
+
+    string text;
+    char buf[4096];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), inf)) > 0)
+        text.append(buf, len);
+    fclose(inf);
+
+    JsonWrapper baseline(json_decode(text.c_str()));
+    if (!baseline.node || baseline->tag != JSON_OBJECT)
+    {
+        fprintf(stderr, "Malformed genbench baseline %s\n", file.c_str());
+        return;
+    }
+
+    printf("\nLevels per second (baseline %s):\n", file.c_str());
+    printf("%-12s %10s %10s %9s\n", "", "before", "after", "change");
+    _compare_line("Total", json_find_member(baseline.node, "total"),
+                  json_find_member(results, "total"));
+
+    JsonNode *old_branches = json_find_member(baseline.node, "branches");
+    JsonNode *new_branches = json_find_member(results, "branches");
+    if (!old_branches || !new_branches)
+        return;
+
+    JsonNode *branch;
+    json_foreach(branch, new_branches)
+    {
+        _compare_line(branch->key, json_find_member(old_branches, branch->key),
+                      branch);
+    }
+}
+
+// Writes per-level and per-branch generation speed as JSON, so that runs
+// with the same seed and levels can be compared.
+static void _write_bench_stats()
+{
+    gen_timing total;
+    map<branch_type, gen_timing> branch_timings;
+    JsonNode *levels(json_mkobject());
+    for (auto &entry : level_timings)
+    {
+        gen_timing &timing = entry.second;
+        const auto builds = map_builds.find(entry.first);
+        if (builds != map_builds.end())
+        {
+            timing.attempts = builds->second.first;
+            timing.vetoes = builds->second.second;
+        }
+        json_append_member(levels, entry.first.describe().c_str(),
+                           _timing_json(timing));
+        branch_timings[entry.first.branch].add(timing);
+        total.add(timing);
+    }
+
+    JsonNode *branch_list(json_mkobject());
+    for (const auto &entry : branch_timings)
+    {
+        json_append_member(branch_list, branches[entry.first].abbrevname,
+                           _timing_json(entry.second));
+    }
+
+    JsonWrapper results(json_mkobject());
+    json_append_member(results.node, "version", json_mkstring(Version::Long));
+    json_append_member(results.node, "seed", json_mknumber(Options.seed));
+    json_append_member(results.node, "iterations",
+                       json_mknumber(SysEnv.map_gen_iters));
+    json_append_member(results.node, "total", _timing_json(total));
+    json_append_member(results.node, "branches", branch_list);
+    json_append_member(results.node, "levels", levels);
+
+    const char *out_file = "genbench.json";
+    FILE *outf = fopen(out_file, "w");
+    if (!outf)
+    {
+        fprintf(stderr, "Unable to open %s: %s\n", out_file,
+                strerror(errno));
+        return;
+    }
+    fprintf(outf, "%s\n", results.to_string().c_str());
+    fclose(outf);
+    printf("Wrote level generation timings to %s: %.2f levels/s.\n",
+           out_file, total.levels_per_sec());
+
+    if (!SysEnv.map_gen_baseline.empty())
+        _compare_with_baseline(results.node, SysEnv.map_gen_baseline);
+}
+
 void mapstat_generate_stats()
 {
     // Warn assertions about possible oddities like the artefact list being
@@ -504,6 +693,8 @@ void mapstat_generate_stats()
     // build.
     mapstat_build_levels();
     _write_map_stats();
+    if (SysEnv.map_gen_bench)
+        _write_bench_stats();
     printf("Map stats complete.\n");
 }
 
@@ -8,11 +8,15 @@
 
 #ifdef DEBUG_STATISTICS
 
+#include <chrono>
+
 class map_def;
 void mapstat_report_map_try(const map_def &map);
 void mapstat_report_map_use(const map_def &map);
 void mapstat_report_map_success(const string &map_name);
 void mapstat_report_error(const map_def &map, const string &err);
+void mapstat_report_map_lua_time(const map_def &map,
+                                 chrono::microseconds elapsed);
 void mapstat_report_map_build_start();
 void mapstat_report_map_veto(const string &message);
 void mapstat_generate_stats();
@@ -121,6 +121,41 @@ bool move_notable_thing(const coord_def& orig, const coord_def& dest)
     return true;
 }
 
+template <typename T>
+static void _shift_notes(map<level_pos, T> &notes, const map_bitmask &area,
+                         const coord_def &delta)
+{
+    const level_id here = level_id::current();
+    map<level_pos, T> shifted;
+    for (auto i = notes.begin(); i != notes.end();)
+    {
+        if (i->first.id == here && area(i->first.pos))
+        {
+            shifted[level_pos(here, i->first.pos + delta)] = i->second;
+            i = notes.erase(i);
+        }
+        else
+            ++i;
+    }
+    for (const auto &entry : shifted)
+        notes[entry.first] = entry.second;
+}
+
+// Moves everything noted in the given area of the current level by delta,
+// as move_notable_thing would for each square. The stash tracker forgets
+// moved shops until they are seen again.
+void shift_notable_things(const map_bitmask &area, const coord_def &delta)
+{
+    for (const auto &entry : shops_present)
+        if (entry.first.id == level_id::current() && area(entry.first.pos))
+            StashTrack.remove_shop(entry.first);
+
+    _shift_notes(shops_present, area, delta);
+    _shift_notes(altars_present, area, delta);
+    _shift_notes(portals_present, area, delta);
+    _shift_notes(portal_notes, area, delta);
+}
+
 static string coloured_branch(branch_type br)
 {
     if (br < 0 || br >= NUM_BRANCHES)
@@ -14,6 +14,7 @@ void overview_clear();
 
 void seen_notable_thing(dungeon_feature_type which_thing, const coord_def& pos);
 bool move_notable_thing(const coord_def& orig, const coord_def& dest);
+void shift_notable_things(const map_bitmask &area, const coord_def &delta);
 bool overview_knows_portal(branch_type portal);
 int  overview_knows_num_portals(dungeon_feature_type portal);
 void display_overview();
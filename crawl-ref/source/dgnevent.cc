@@ -35,6 +35,15 @@ void dgn_event_dispatcher::move_listeners(
     grid_triggers[to.x][to.y] = move(grid_triggers[from.x][from.y]);
 }
 
+// Moves all listeners in the rectangle from tl to br by delta, discarding
+// any moved out of it.
+void dgn_event_dispatcher::shift_listeners(const coord_def &tl,
+                                           const coord_def &br,
+                                           const coord_def &delta)
+{
+    shift_grid_rect(grid_triggers, tl, br, delta, nullptr);
+}
+
 bool dgn_event_dispatcher::has_listeners_at(const coord_def &pos) const
 {
     return grid_triggers[pos.x][pos.y].get();
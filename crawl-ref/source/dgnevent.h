@@ -105,6 +105,8 @@ public:
     void clear_listeners_at(const coord_def &pos);
     bool has_listeners_at(const coord_def &pos) const;
     void move_listeners(const coord_def &from, const coord_def &to);
+    void shift_listeners(const coord_def &tl, const coord_def &br,
+                         const coord_def &delta);
 
     // Returns false if the event is vetoed.
     bool fire_vetoable_position_event(const dgn_event &e,
@@ -20,12 +20,71 @@ static int dlua_compiled_chunk_writer(lua_State *ls, const void *p,
     return 0;
 }
 
+// The interpreters dlua_loaded_chunk may still unref from. Each one gets a
+// single shutdown listener, however many chunks it loads.
+class dlua_open_interpreters : public lua_shutdown_listener
+{
+public:
+    void add(CLua &interp)
+    {
+        if (open.insert(&interp).second)
+            interp.add_shutdown_listener(this);
+    }
+
+    bool contains(const CLua &interp) const
+    {
+        return open.count(&interp);
+    }
+
+    void shutdown(CLua &interp) override
+    {
+        open.erase(&interp);
+    }
+
+private:
+    set<const CLua *> open;
+};
+
+// Never destroyed, since interpreters shutting down at exit still call it.
+static dlua_open_interpreters &_open_interpreters()
+{
+    static dlua_open_interpreters *open = new dlua_open_interpreters;
+    return *open;
+}
+
+// A function left by dlua_chunk::load(), kept in the interpreter's registry
+// until the last copy of the chunk lets go of it.
+struct dlua_loaded_chunk
+{
+    // Refers to the function on top of the stack, leaving it there.
+    dlua_loaded_chunk(CLua &_interp) : interp(_interp)
+    {
+        _open_interpreters().add(interp);
+        lua_pushvalue(interp, -1);
+        ref = luaL_ref(interp, LUA_REGISTRYINDEX);
+    }
+
+    ~dlua_loaded_chunk()
+    {
+        if (_open_interpreters().contains(interp))
+            luaL_unref(interp, LUA_REGISTRYINDEX, ref);
+    }
+
+    void push() const
+    {
+        lua_rawgeti(interp, LUA_REGISTRYINDEX, ref);
+    }
+
+    CLua &interp;
+    int ref;
+};
+
 ///////////////////////////////////////////////////////////////////////////
 // dlua_chunk
 
 dlua_chunk::dlua_chunk(const string &_context)
     : file(), chunk(), compiled(), context(_context), first(-1),
-      last(-1), error()
+      last(-1), loaded(), error()
 {
     clear();
 }
@@ -33,7 +92,8 @@ dlua_chunk::dlua_chunk(const string &_context)
 // Initialises a chunk from the function on the top of stack.
 // This function must not be a closure, i.e. must not have any upvalues.
 dlua_chunk::dlua_chunk(lua_State *ls)
-    : file(), chunk(), compiled(), context(), first(-1), last(-1), error()
+    : file(), chunk(), compiled(), context(), first(-1), last(-1),
+      loaded(), error()
 {
     clear();
 
@@ -112,6 +172,7 @@ void dlua_chunk::clear()
     first = last = -1;
     error.clear();
     compiled.clear();
+    loaded.reset();
 }
 
 void dlua_chunk::set_file(const string &s)
@@ -133,11 +194,13 @@ void dlua_chunk::add(int line, const string &s)
     chunk += " ";
     chunk += s;
     last = line;
+    loaded.reset();
 }
 
 void dlua_chunk::set_chunk(const string &s)
 {
     chunk = s;
+    loaded.reset();
 }
 
 int dlua_chunk::check_op(CLua &interp, int err)
@@ -146,13 +209,30 @@ int dlua_chunk::check_op(CLua &interp, int err)
     return err;
 }
 
+// Pushes the function left by an earlier load() into the same interpreter.
+bool dlua_chunk::push_loaded(CLua &interp) const
+{
+    if (!loaded || &loaded->interp != &interp)
+        return false;
+
+    loaded->push();
+    return true;
+}
+
 int dlua_chunk::load(CLua &interp)
 {
+    if (push_loaded(interp))
+        return 0;
+
     if (!compiled.empty())
     {
-        return check_op(interp,
-                         interp.loadbuffer(compiled.c_str(), compiled.length(),
-                                           context.c_str()));
+        const int err =
+            check_op(interp,
+                     interp.loadbuffer(compiled.c_str(), compiled.length(),
+                                       context.c_str()));
+        if (!err)
+            loaded = make_shared<dlua_loaded_chunk>(interp);
+        return err;
     }
 
     if (empty())
@@ -173,6 +253,8 @@ int dlua_chunk::load(CLua &interp)
         error = e? e : "Unknown error compiling chunk";
         lua_pop(interp, 2);
     }
+    else
+        loaded = make_shared<dlua_loaded_chunk>(interp);
     compiled = out.str();
     return err;
 }
@@ -20,6 +20,7 @@ const int E_CHUNK_LOAD_FAILURE = -1000;
 
 class reader;
 class writer;
+struct dlua_loaded_chunk;
 
 class dlua_chunk
 {
@@ -30,6 +31,11 @@ private:
     string context;
     int first, last;     // First and last lines of the original source.
 
+    // The function produced by the last successful load(), shared between
+    // copies of this chunk so that each map is only compiled once per
+    // interpreter.
+    mutable shared_ptr<dlua_loaded_chunk> loaded;
+
     enum chunk_t
     {
         CT_EMPTY,
@@ -39,6 +45,7 @@ private:
 
 private:
     int check_op(CLua &, int);
+    bool push_loaded(CLua &interp) const;
     string rewrite_chunk_prefix(const string &line, bool skip_body = false) const;
     string get_chunk_prefix(const string &s) const;
 
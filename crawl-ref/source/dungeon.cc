@@ -325,7 +325,8 @@ bool builder(bool enable_random_maps, dungeon_feature_type dest_stairs_type)
         you.uniq_map_names = uniq_names;
     }
 
-    if (!crawl_state.map_stat_gen && !crawl_state.obj_stat_gen)
+    if (!crawl_state.map_stat_gen && !crawl_state.obj_stat_gen
+        && !crawl_state.pregen_helper)
     {
         // Failed to build level, bail out.
         if (crawl_state.need_save)
@@ -1350,6 +1351,7 @@ void fixup_misplaced_items()
         item.base_type = OBJ_UNASSIGNED;
         item.quantity = 0;
         item.pos.reset();
+        mitm_slot_freed(item.index());
     }
 }
 
@@ -16,6 +16,7 @@
 #include "database.h"
 #include "describe.h"
 #include "dungeon.h"
+#include "files.h"
 #include "godpassive.h"
 #include "hints.h"
 #include "invent.h"
@@ -23,6 +24,7 @@
 #include "los.h"
 #include "macro.h"
 #include "message.h"
+#include "mon-cast.h"
 #include "prompt.h"
 #include "religion.h"
 #include "state.h"
@@ -150,6 +152,18 @@ NORETURN void end(int exit_code, bool print_error, const char *format, ...)
 #ifdef DEBUG_PROPS
         dump_prop_accesses();
 #endif
+#ifdef DEBUG_SPELL_COSTS
+        dump_spell_costs();
+#endif
+#ifdef DEBUG_CONSOLE_FRAMES
+        dump_console_frame_stats();
+#endif
+#ifdef DEBUG_MESSAGE_FILTERS
+        dump_message_filter_costs();
+#endif
+#ifdef DEBUG_PATTERN_CACHE
+        text_pattern_list::dump_stats();
+#endif
 
         if (!error.empty())
         {
@@ -193,6 +207,7 @@ NORETURN void end(int exit_code, bool print_error, const char *format, ...)
 static void _delete_files()
 {
     crawl_state.need_save = false;
+    discard_pregenerated_levels();
     you.save->unlink();
     delete you.save;
     you.save = 0;
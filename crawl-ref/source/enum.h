@@ -4939,6 +4939,7 @@ enum uncancellable_type
 enum seed_type
 {
     SEED_PASSIVE_MAP,          // determinist magic mapping
+    SEED_LEVELGEN,             // per-game key for persistent levels
     NUM_SEEDS
 };
 
@@ -5171,6 +5172,7 @@ enum timed_effect_type
 enum rng_type {
     RNG_GAMEPLAY,
     RNG_UI,
+    RNG_LEVELGEN,     // persistent levels, reseeded per level
     NUM_RNGS,
 };
 
@@ -407,6 +407,7 @@ static void _exclude_update()
 {
     set_level_exclusion_annotation(curr_excludes.get_exclusion_desc());
     travel_cache.update_excludes();
+    forget_travel_route();
 }
 
 static void _exclude_update(const coord_def &p)
@@ -333,6 +333,42 @@ struct cloud_struct
     static killer_type   whose_to_killer(kill_category whose);
 };
 
+// The clouds on a level. They are packed densely for iteration, with a
+// per-cell index into the list (like mgrid for monsters) for lookups by
+// position. Adding or removing a cloud may move other clouds around in
+// the list, so don't hold on to references across such changes.
+class cloud_list
+{
+public:
+    typedef vector<cloud_struct>::iterator       iterator;
+    typedef vector<cloud_struct>::const_iterator const_iterator;
+
+    cloud_list();
+
+    cloud_struct *find(const coord_def &pos);
+    const cloud_struct *find(const coord_def &pos) const;
+
+    // Stores a copy of cloud at pos, replacing any cloud already there.
+    cloud_struct &set(const coord_def &pos, const cloud_struct &cloud);
+    void erase(const coord_def &pos);
+    void move(const coord_def &src, const coord_def &dst);
+    void swap(const coord_def &p1, const coord_def &p2);
+    void shift(const coord_def &delta);
+    void clear();
+
+    size_t size() const { return clouds.size(); }
+    bool empty() const { return clouds.empty(); }
+
+    iterator begin() { return clouds.begin(); }
+    iterator end() { return clouds.end(); }
+    const_iterator begin() const { return clouds.begin(); }
+    const_iterator end() const { return clouds.end(); }
+
+private:
+    vector<cloud_struct> clouds;
+    FixedArray<int, GXM, GYM> index;    // into clouds, or -1
+};
+
 struct shop_struct
 {
     coord_def           pos;
@@ -823,6 +859,8 @@ public:
     string property_at(const coord_def &c, map_marker_type type,
                        const char *key)
     { return property_at(c, type, string(key)); }
+    // Positions holding a marker that might have the given property.
+    set<coord_def> property_positions(const string &key) const;
     void clear();
 
     void write(writer &) const;
@@ -835,10 +873,20 @@ private:
     void init_from(const map_markers &);
     void unlink_marker(const map_marker *);
     void check_empty();
+    void index_marker(map_marker *);
+    void unindex_marker(const map_marker *);
+    bool no_markers_at(const coord_def &c) const;
 
 private:
     dgn_marker_map markers;
     bool have_inactive_markers;
+
+    // Number of markers on each cell, to answer for empty cells quickly.
+    FixedArray<unsigned short, GXM, GYM> cell_markers;
+    // Markers by the names of their static properties.
+    multimap<string, map_marker *> prop_index;
+    // Markers whose properties can't be indexed.
+    set<map_marker *> dynamic_markers;
 };
 
 class InvEntry;
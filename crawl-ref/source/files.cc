@@ -22,6 +22,8 @@
 #endif
 #include <sys/types.h>
 #ifdef UNIX
+#include <csignal>
+#include <sys/wait.h>
 #include <unistd.h>
 #endif
 
@@ -59,6 +61,7 @@
 #include "output.h"
 #include "place.h"
 #include "prompt.h"
+#include "random.h"
 #include "spl-summoning.h"
 #include "state.h"
 #include "stringutil.h"
@@ -93,6 +96,8 @@ static bool _restore_tagged_chunk(package *save, const string &name,
                                   tag_type tag, const char* complaint);
 static bool _read_char_chunk(package *save);
 
+static bool _restore_pregenerated_level(const level_id &lid);
+
 const short GHOST_SIGNATURE = short(0xDC55);
 
 const int GHOST_LIMIT = 27; // max number of ghost files per level
@@ -1082,6 +1087,36 @@ static bool _leave_level(dungeon_feature_type stair_taken,
 }
 
 
+/**
+ * Build the current level from scratch.
+ *
+ * Levels in the connected branches are built from their own RNG stream,
+ * seeded from the game's level generation key and the level's place, so
+ * that what gets built doesn't depend on anything drawn from the gameplay
+ * RNG beforehand. This is what lets pregenerate_levels() build them ahead
+ * of time.
+ *
+ * @param stair_type    The stair the player will arrive by.
+ * @return Whether the level was built successfully.
+ */
+static bool _generate_level(dungeon_feature_type stair_type)
+{
+    tile_init_default_flavour();
+    tile_clear_flavour();
+    env.tile_names.clear();
+    _clear_env_map();
+
+    if (!is_connected_branch(you.where_are_you))
+        return builder(true, stair_type);
+
+    uint64_t key[2] = { you.game_seeds[SEED_LEVELGEN],
+                        static_cast<uint64_t>(you.where_are_you) << 8
+                        | you.depth };
+    seed_rng(RNG_LEVELGEN, key, ARRAYSZ(key));
+    rng_generator levelgen(RNG_LEVELGEN);
+    return builder(true, stair_type);
+}
+
 /**
  * Generate a new level.
  *
@@ -1106,10 +1141,6 @@ static void _make_level(dungeon_feature_type stair_taken,
         you.chapter = CHAPTER_ORB_HUNTING;
     }
 
-    tile_init_default_flavour();
-    tile_clear_flavour();
-    env.tile_names.clear();
-
     // XXX: This is ugly.
     bool dummy;
     dungeon_feature_type stair_type = static_cast<dungeon_feature_type>(
@@ -1117,8 +1148,8 @@ static void _make_level(dungeon_feature_type stair_taken,
                              static_cast<dungeon_feature_type>(stair_taken),
                              dummy));
 
-    _clear_env_map();
-    builder(true, stair_type);
+    if (!_restore_pregenerated_level(level_id::current()))
+        _generate_level(stair_type);
 
     if (!crawl_state.game_is_tutorial()
         && !Options.seed
@@ -1495,6 +1526,9 @@ bool load_level(dungeon_feature_type stair_taken, load_mode_type load_mode,
     }
 #endif
 
+    if (make_changes || load_mode == LOAD_RESTART_GAME)
+        pregenerate_levels();
+
     return just_created_level;
 }
 
@@ -1577,6 +1611,8 @@ static void _save_game_exit()
     if (!you.entering_level)
         _save_level(level_id::current());
 
+    discard_pregenerated_levels();
+
     clrscr();
 
 #ifdef DGL_WHEREIS
@@ -2029,6 +2065,284 @@ level_excursion::~level_excursion()
     }
 }
 
+#define PREGEN_SUFFIX ".pregen"
+// How many monster ids each background build leaves the game to use before
+// it starts on its own, so that the level stays usable while the player
+// makes monsters elsewhere (summons, spawns, other levels).
+#define PREGEN_MID_GAP 100000
+
+#ifdef UNIX
+// The process building levels in the background, or 0 if there is none.
+static pid_t _pregen_pid = 0;
+// The levels that process has been asked to build.
+static set<level_id> _pregen_pending;
+#endif
+// Every level handed to a background process this session.
+static set<level_id> _pregen_requested;
+
+static string _pregen_filename(const level_id &lid)
+{
+    return get_savedir_filename(you.your_name) + "-"
+           + replace_all(lid.describe(), ":", "-") + PREGEN_SUFFIX;
+}
+
+#ifdef UNIX
+static void _wait_for_pregen(bool block)
+{
+    if (_pregen_pid
+        && waitpid(_pregen_pid, nullptr, block ? 0 : WNOHANG) != 0)
+    {
+        _pregen_pid = 0;
+        _pregen_pending.clear();
+    }
+}
+
+static void _stop_pregen()
+{
+    if (!_pregen_pid)
+        return;
+
+    // The helper leads its own process group, which includes the worker
+    // building the current level.
+    kill(-_pregen_pid, SIGTERM);
+    _wait_for_pregen(true);
+}
+
+/**
+ * Build one level in a throwaway worker process and store it, along with
+ * the level generation state it was built from and left behind, in its
+ * own package next to the save.
+ *
+ * @param lid   The level to build.
+ * @param slot  Which of this helper's levels it is, picking the range of
+ *              monster ids it is built with.
+ */
+static void _pregen_level(const level_id &lid, int slot)
+{
+    vector<unsigned char> built_from;
+    writer before(&built_from);
+    marshall_levelgen_state(before);
+    you.last_mid += PREGEN_MID_GAP * (slot + 1);
+    const mid_t first_mid = you.last_mid;
+    const int first_gold = you.attribute[ATTR_GOLD_GENERATED];
+
+    you.where_are_you = lid.branch;
+    you.depth         = lid.depth;
+    you.position.reset();
+    env.turns_on_level = -1;
+
+    // builder() only passes the arrival stair along to places that don't
+    // look at it, so the level doesn't depend on which stair is taken.
+    if (!_generate_level(DNGN_STONE_STAIRS_UP_I))
+        return;
+
+    fix_item_coordinates();
+
+    const string filename = _pregen_filename(lid);
+    const string tmpname = filename + ".tmp";
+    {
+        package pkg(tmpname.c_str(), true, true);
+        {
+            writer outf(&pkg, "state");
+            marshallUByte(outf, TAG_MAJOR_VERSION);
+            marshallUByte(outf, TAG_MINOR_VERSION);
+            marshallInt(outf, first_mid);
+            marshallInt(outf, you.last_mid);
+            marshallInt(outf, you.attribute[ATTR_GOLD_GENERATED] - first_gold);
+            marshallInt(outf, built_from.size());
+            outf.write(&built_from[0], built_from.size());
+            marshall_levelgen_state(outf);
+        }
+        {
+            writer outf(&pkg, "level");
+            marshallUByte(outf, TAG_MAJOR_VERSION);
+            marshallUByte(outf, TAG_MINOR_VERSION);
+            tag_write(TAG_LEVEL, outf);
+        }
+    }
+    rename_u(tmpname.c_str(), filename.c_str());
+}
+
+// Detach a freshly forked helper from the terminal and the save.
+static void _become_pregen_helper()
+{
+    setpgid(0, 0);
+    signal(SIGHUP, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+
+    const int devnull = open("/dev/null", O_RDWR);
+    if (devnull != -1)
+    {
+        dup2(devnull, STDIN_FILENO);
+        dup2(devnull, STDOUT_FILENO);
+        dup2(devnull, STDERR_FILENO);
+        close(devnull);
+    }
+    if (nice(10) == -1)
+        dprf("couldn't lower the level generation helper's priority");
+
+    crawl_state.io_inited     = false;
+    crawl_state.need_save     = false;
+    crawl_state.pregen_helper = true;
+}
+#endif
+
+/**
+ * Start building the levels the player is likely to visit next, so that
+ * load_level() can pick them up instead of running the builder: the next
+ * level of this branch and the first level of any branch entered from
+ * here. Each is built in its own forked worker from the state as it is
+ * now, so one level being built never affects another.
+ */
+void pregenerate_levels()
+{
+#ifdef UNIX
+    if (!Options.pregen_levels || !you.save || crawl_state.game_is_arena()
+        || crawl_state.pregen_helper)
+    {
+        return;
+    }
+
+    _stop_pregen();
+
+    vector<level_id> wanted;
+    const level_id here = level_id::current();
+    if (is_connected_branch(here) && here.depth < brdepth[here.branch])
+        wanted.emplace_back(here.branch, here.depth + 1);
+    for (branch_iterator it; it; ++it)
+    {
+        if (brentry[it->id] == here && brdepth[it->id] > 0
+            && is_connected_branch(it->id))
+        {
+            wanted.emplace_back(it->id, 1);
+        }
+    }
+    wanted.erase(remove_if(wanted.begin(), wanted.end(), is_existing_level),
+                 wanted.end());
+    if (wanted.empty())
+        return;
+
+    const pid_t pid = fork();
+    if (pid == -1)
+    {
+        dprf("couldn't fork a level generation helper: %s", strerror(errno));
+        return;
+    }
+    if (pid)
+    {
+        _pregen_pid = pid;
+        _pregen_pending.insert(wanted.begin(), wanted.end());
+        _pregen_requested.insert(wanted.begin(), wanted.end());
+        return;
+    }
+
+    _become_pregen_helper();
+    for (size_t i = 0; i < wanted.size(); ++i)
+    {
+        const pid_t worker = fork();
+        if (worker == 0)
+        {
+            _pregen_level(wanted[i], i);
+            _exit(0);
+        }
+        if (worker != -1)
+            waitpid(worker, nullptr, 0);
+    }
+    _exit(0);
+#endif
+}
+
+/**
+ * Stop any background level generation and remove the levels it built.
+ */
+void discard_pregenerated_levels()
+{
+#ifdef UNIX
+    _stop_pregen();
+#endif
+    for (const level_id &lid : _pregen_requested)
+    {
+        const string filename = _pregen_filename(lid);
+        unlink_u(filename.c_str());
+        unlink_u((filename + ".tmp").c_str());
+    }
+    _pregen_requested.clear();
+}
+
+/**
+ * If a background process built the given level, and the level generation
+ * state is still what it was built from, install that level and the state
+ * building it left behind, just as if builder() had run now.
+ *
+ * @return Whether a pregenerated level was used.
+ */
+static bool _restore_pregenerated_level(const level_id &lid)
+{
+#ifdef UNIX
+    if (!Options.pregen_levels || !is_connected_branch(lid))
+        return false;
+
+    _wait_for_pregen(_pregen_pending.count(lid));
+
+    const string filename = _pregen_filename(lid);
+    if (!file_exists(filename))
+        return false;
+
+    bool restored = false;
+    try
+    {
+        package pkg(filename.c_str(), false);
+        reader inf(&pkg, "state", TAG_MINOR_VERSION);
+        const int major = inf.readByte();
+        const int minor = inf.readByte();
+        if (major != TAG_MAJOR_VERSION || minor != TAG_MINOR_VERSION)
+            throw corrupted_save("pregenerated level from another version");
+
+        const mid_t first_mid = unmarshallInt(inf);
+        const mid_t last_mid = unmarshallInt(inf);
+        const int gold = unmarshallInt(inf);
+        vector<unsigned char> built_from(unmarshallInt(inf));
+        inf.read(&built_from[0], built_from.size());
+
+        vector<unsigned char> now;
+        writer current(&now);
+        marshall_levelgen_state(current);
+
+        const coord_def old_player_pos = env.old_player_pos;
+        if (built_from != now)
+            dprf("Pregenerated %s is out of date.", lid.describe().c_str());
+        // The level was built with mids the game had not reached yet. If
+        // it has since, they clash, and mids are kept in too many places
+        // (band leaders, summoners, tentacles, enchantment sources, clouds,
+        // markers...) to renumber safely.
+        else if (you.last_mid > first_mid)
+            dprf("Pregenerated %s has stale mids.", lid.describe().c_str());
+        else if (_restore_tagged_chunk(&pkg, "level", TAG_LEVEL, nullptr))
+        {
+            env.old_player_pos = old_player_pos;
+            unmarshall_levelgen_state(inf);
+            you.last_mid = last_mid;
+            you.attribute[ATTR_GOLD_GENERATED] += gold;
+            restored = true;
+        }
+    }
+    catch (ext_fail_exception &fe)
+    {
+        dprf("Couldn't use pregenerated %s: %s", lid.describe().c_str(),
+             fe.what());
+    }
+    catch (short_read_exception &E)
+    {
+        dprf("Pregenerated %s is truncated.", lid.describe().c_str());
+    }
+
+    unlink_u(filename.c_str());
+    return restored;
+#else
+    return false;
+#endif
+}
+
 bool get_save_version(reader &file, int &major, int &minor)
 {
     // Read first two bytes.
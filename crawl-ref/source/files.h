@@ -96,6 +96,9 @@ bool restore_game(const string& filename);
 
 bool is_existing_level(const level_id &level);
 
+void pregenerate_levels();
+void discard_pregenerated_levels();
+
 class level_excursion
 {
 protected:
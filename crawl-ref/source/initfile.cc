@@ -837,6 +837,8 @@ void game_options::reset_options()
     show_travel_trail       = false;
 #endif
 
+    runrest_max_fps        = 0;
+
     travel_stair_cost      = 500;
 
     view_delay             = DEFAULT_VIEW_DELAY;
@@ -879,6 +881,7 @@ void game_options::reset_options()
     use_fake_cursor        = false;
 #endif
     use_fake_player_cursor = true;
+    pregen_levels          = false;
     show_player_species    = false;
     explore_stop           = (ES_ITEM | ES_STAIR | ES_PORTAL | ES_BRANCH
                               | ES_SHOP | ES_ALTAR | ES_RUNED_DOOR
@@ -1140,6 +1143,8 @@ void game_options::reset_options()
     sound_mappings.clear();
     menu_colour_mappings.clear();
     message_colour_mappings.clear();
+    message_filters_generation++;
+    item_patterns_generation++;
     drop_filter.clear();
     map_file_name.clear();
     named_options.clear();
@@ -1546,6 +1551,7 @@ void read_init_file(bool runscript)
             if (!clua.error.empty())
                 mprf(MSGCH_ERROR, "Lua error: %s", clua.error.c_str());
         }
+        remember_builtin_stash_hooks();
     }
 
     // Load default options.
@@ -1696,6 +1702,8 @@ void read_options(const string &s, bool runscript, bool clear_aliases)
 game_options::game_options()
     : seed(0), no_save(false), language(LANG_EN), lang_name(nullptr)
 {
+    message_filters_generation = 0;
+    item_patterns_generation = 0;
     reset_options();
 }
 
@@ -2877,7 +2885,12 @@ void game_options::read_option_line(const string &str, bool runscript)
     else INT_OPTION(autofight_warning, 0, 1000);
     else INT_OPTION_NAMED("mp_warning", magic_point_warning, 0, 100);
     else LIST_OPTION(note_monsters);
-    else LIST_OPTION(note_messages);
+    else if (key == "note_messages")
+    {
+        _handle_list(note_messages, field, plus_equal, caret_equal,
+                     minus_equal);
+        message_filters_generation++;
+    }
     else INT_OPTION(note_hp_percent, 0, 100);
 #ifndef DGAMELAUNCH
     // If DATA_DIR_PATH is set, don't set crawl_dir from .crawlrc.
@@ -3017,6 +3030,7 @@ void game_options::read_option_line(const string &str, bool runscript)
     }
     else if (key == "ban_pickup")
     {
+        item_patterns_generation++;
         // Only remove negative, not positive, exceptions.
         if (plain)
             erase_if(force_autopickup, _is_autopickup_ban);
@@ -3038,6 +3052,7 @@ void game_options::read_option_line(const string &str, bool runscript)
     }
     else if (key == "autopickup_exceptions")
     {
+        item_patterns_generation++;
         if (plain)
             force_autopickup.clear();
 
@@ -3063,7 +3078,11 @@ void game_options::read_option_line(const string &str, bool runscript)
         }
         _merge_lists(force_autopickup, new_entries, caret_equal);
     }
-    else LIST_OPTION(note_items);
+    else if (key == "note_items")
+    {
+        item_patterns_generation++;
+        _handle_list(note_items, field, plus_equal, caret_equal, minus_equal);
+    }
 #ifndef _MSC_VER
     // break if-else chain on broken Microsoft compilers with stupid nesting limits
     else
@@ -3071,6 +3090,7 @@ void game_options::read_option_line(const string &str, bool runscript)
 
     if (key == "autoinscribe")
     {
+        item_patterns_generation++;
         if (plain)
             autoinscriptions.clear();
 
@@ -3384,6 +3404,7 @@ void game_options::read_option_line(const string &str, bool runscript)
             level_map_cursor_step = 50;
     }
     else BOOL_OPTION(use_fake_cursor);
+    else BOOL_OPTION(pregen_levels);
     else BOOL_OPTION(use_fake_player_cursor);
     else BOOL_OPTION(show_player_species);
     else if (key == "force_more_message" || key == "flash_screen_message")
@@ -3418,6 +3439,7 @@ void game_options::read_option_line(const string &str, bool runscript)
                 new_entries.push_back(mf);
         }
         _merge_lists(filters, new_entries, caret_equal);
+        message_filters_generation++;
     }
     else LIST_OPTION(confirm_action);
     else LIST_OPTION(drop_filter);
@@ -3517,6 +3539,7 @@ void game_options::read_option_line(const string &str, bool runscript)
 #endif
     if (key == "menu_colour" || key == "menu_color")
     {
+        item_patterns_generation++;
         if (plain)
             menu_colour_mappings.clear();
 
@@ -3563,6 +3586,7 @@ void game_options::read_option_line(const string &str, bool runscript)
             message_colour_mappings.clear();
 
         add_message_colour_mappings(field, caret_equal, minus_equal);
+        message_filters_generation++;
     }
     else if (key == "dump_order")
     {
@@ -3776,6 +3800,7 @@ void game_options::read_option_line(const string &str, bool runscript)
     else INT_OPTION(tile_tooltip_ms, 0, INT_MAX);
     else INT_OPTION(tile_update_rate, 50, INT_MAX);
     else INT_OPTION(tile_runrest_rate, 0, INT_MAX);
+    else INT_OPTION(runrest_max_fps, 0, 1000);
     else BOOL_OPTION(tile_show_minihealthbar);
     else BOOL_OPTION(tile_show_minimagicbar);
     else BOOL_OPTION(tile_show_demon_tier);
@@ -4194,6 +4219,7 @@ enum commandline_option_type
     CLO_MAPSTAT,
     CLO_OBJSTAT,
     CLO_ITERATIONS,
+    CLO_GENBENCH,
     CLO_ARENA,
     CLO_DUMP_MAPS,
     CLO_TEST,
@@ -4231,7 +4257,8 @@ static const char *cmd_ops[] =
 {
     "scores", "name", "species", "background", "dir", "rc",
     "rcdir", "tscores", "vscores", "scorefile", "morgue", "macro",
-    "mapstat", "objstat", "iters", "arena", "dump-maps", "test", "script",
+    "mapstat", "objstat", "iters", "genbench", "arena", "dump-maps", "test",
+    "script",
     "builddb", "help", "version", "seed", "save-version", "sprint",
     "extra-opt-first", "extra-opt-last", "sprint-map", "edit-save",
     "print-charset", "tutorial", "wizard", "explore", "no-save",
@@ -4666,6 +4693,7 @@ bool parse_args(int argc, char **argv, bool rc_only)
 
     SysEnv.rcdirs.clear();
     SysEnv.map_gen_iters = 0;
+    SysEnv.map_gen_bench = false;
 
     if (argc < 2)           // no args!
         return true;
@@ -4845,6 +4873,29 @@ bool parse_args(int argc, char **argv, bool rc_only)
 #endif
             break;
 
+        case CLO_GENBENCH:
+#ifdef DEBUG_STATISTICS
+            // A mapstat run that also records timings; -mapstat may still
+            // be given to narrow the levels.
+            crawl_state.map_stat_gen = true;
+            SysEnv.map_gen_bench = true;
+#ifdef USE_TILE_LOCAL
+            crawl_state.tiles_disabled = true;
+#endif
+            if (!SysEnv.map_gen_iters)
+                SysEnv.map_gen_iters = 100;
+            if (next_is_param)
+            {
+                SysEnv.map_gen_baseline = next_arg;
+                nextUsed = true;
+            }
+#else
+            fprintf(stderr, "genbench is available only in "
+                    "DEBUG_STATISTICS builds.\n");
+            end(1);
+#endif
+            break;
+
         case CLO_ARENA:
             if (!rc_only)
             {
@@ -58,6 +58,8 @@ public:
 
     int map_gen_iters;
     unique_ptr<depth_ranges> map_gen_range;
+    bool map_gen_bench;            // Write level generation timings.
+    string map_gen_baseline;       // Earlier timings to compare against.
 
     vector<string> extra_opts_first;
     vector<string> extra_opts_last;
@@ -3164,12 +3164,16 @@ bool is_interesting_item(const item_def& item)
     if (fully_identified(item) && is_artefact(item))
         return true;
 
-    const string iname = item_prefix(item, false) + " " + item.name(DESC_PLAIN);
-    for (const text_pattern &pat : Options.note_items)
-        if (pat.matches(iname))
-            return true;
+    static text_pattern_list patterns("note_items");
+    if (!patterns.current(Options.item_patterns_generation))
+    {
+        patterns.reset(Options.item_patterns_generation);
+        for (const text_pattern &pat : Options.note_items)
+            patterns.add(pat);
+    }
 
-    return false;
+    const string iname = item_prefix(item, false) + " " + item.name(DESC_PLAIN);
+    return !patterns.matches(iname).empty();
 }
 
 /**
@@ -450,12 +450,25 @@ void inc_mitm_item_quantity(int obj, int amount)
     mitm[obj].quantity += amount;
 }
 
+// The lowest mitm slot that may be free; every slot below it is in use.
+// Anything that empties a slot must report it through mitm_slot_freed(),
+// so that get_mitm_slot() can skip the used prefix and still hand out the
+// lowest free index.
+static int _first_free_item = 0;
+
+void mitm_slot_freed(int item)
+{
+    if (item >= 0 && item < _first_free_item)
+        _first_free_item = item;
+}
+
 void init_item(int item)
 {
     if (item == NON_ITEM)
         return;
 
     mitm[item].clear();
+    mitm_slot_freed(item);
 }
 
 // Returns an unused mitm slot, or NON_ITEM if none available.
@@ -470,10 +483,14 @@ int get_mitm_slot(int reserve)
 
     int item = NON_ITEM;
 
-    for (item = 0; item < (MAX_ITEMS - reserve); item++)
+    for (item = _first_free_item; item < (MAX_ITEMS - reserve); item++)
         if (!mitm[item].defined())
             break;
 
+    // Everything scanned so far is in use; a reserved tail is not, and is
+    // still rescanned by later calls with a smaller reserve.
+    _first_free_item = item;
+
     if (item >= MAX_ITEMS - reserve)
     {
         if (crawl_state.game_is_arena())
@@ -592,6 +609,7 @@ void unlink_item(int dest)
     mitm[dest].link      = NON_ITEM;
     mitm[dest].pos.reset();
     mitm[dest].props.clear();
+    mitm_slot_freed(dest);
 
     // Look through all items for links to this item.
     for (auto &item : mitm)
@@ -650,7 +668,11 @@ void destroy_item(int dest, bool never_created)
     // Don't destroy non-items, but this function may be called upon
     // to remove items reduced to zero quantity, so we allow "invalid"
     // objects in.
-    if (dest == NON_ITEM || !mitm[dest].defined())
+    if (dest == NON_ITEM)
+        return;
+
+    mitm_slot_freed(dest);
+    if (!mitm[dest].defined())
         return;
 
     unlink_item(dest);
@@ -2651,23 +2673,28 @@ static void _autoinscribe_item(item_def& item)
 
     string iname = _autopickup_item_name(item);
 
-    for (const auto &ai_entry : Options.autoinscriptions)
+    static text_pattern_list patterns("autoinscribe");
+    if (!patterns.current(Options.item_patterns_generation))
     {
-        if (ai_entry.first.matches(iname))
-        {
-            // Don't autoinscribe dropped items on ground with
-            // "=g". If the item matches a rule which adds "=g",
-            // "=g" got added to it before it was dropped, and
-            // then the user explicitly removed it because they
-            // don't want to autopickup it again.
-            string str = ai_entry.second;
-            if ((item.flags & ISFLAG_DROPPED) && !in_inventory(item))
-                str = replace_all(str, "=g", "");
-
-            // Note that this might cause the item inscription to
-            // pass 80 characters.
-            item.inscription += str;
-        }
+        patterns.reset(Options.item_patterns_generation);
+        for (const auto &ai_entry : Options.autoinscriptions)
+            patterns.add(ai_entry.first);
+    }
+
+    for (int i : patterns.matches(iname))
+    {
+        // Don't autoinscribe dropped items on ground with
+        // "=g". If the item matches a rule which adds "=g",
+        // "=g" got added to it before it was dropped, and
+        // then the user explicitly removed it because they
+        // don't want to autopickup it again.
+        string str = Options.autoinscriptions[i].second;
+        if ((item.flags & ISFLAG_DROPPED) && !in_inventory(item))
+            str = replace_all(str, "=g", "");
+
+        // Note that this might cause the item inscription to
+        // pass 80 characters.
+        item.inscription += str;
     }
     if (!old_inscription.empty())
     {
@@ -2785,9 +2812,17 @@ static bool _is_option_autopickup(const item_def &item, bool ignore_force)
 #endif
 
     // Check for initial settings
-    for (const pair<text_pattern, bool>& option : Options.force_autopickup)
-        if (option.first.matches(iname))
-            return option.second;
+    static text_pattern_list patterns("autopickup_exceptions");
+    if (!patterns.current(Options.item_patterns_generation))
+    {
+        patterns.reset(Options.item_patterns_generation);
+        for (const pair<text_pattern, bool>& option : Options.force_autopickup)
+            patterns.add(option.first);
+    }
+
+    const vector<int> &matches = patterns.matches(iname);
+    if (!matches.empty())
+        return Options.force_autopickup[matches[0]].second;
 
     return Options.autopickups[item.base_type];
 }
@@ -57,6 +57,7 @@ item_def *find_floor_item(object_class_type cls, int sub_type = -1);
 int item_on_floor(const item_def &item, const coord_def& where);
 
 void init_item(int item);
+void mitm_slot_freed(int item);
 
 void link_items();
 
@@ -66,6 +66,39 @@ static int curs_bg_attr(int col);
 
 static bool cursor_is_enabled = true;
 
+// What puttext() last left in each screen cell, so that cells it would
+// only repeat need not go through curses again. Every other way of writing
+// to the screen forgets the cells it touches.
+struct shown_cell
+{
+    ucs_t glyph;
+    int colour; // -1 if unknown
+};
+static vector<shown_cell> shown_cells;
+
+static void _forget_shown_cells(int from, int to)
+{
+    from = max(from, 0);
+    to = min<int>(to, shown_cells.size());
+    for (int i = from; i < to; ++i)
+        shown_cells[i].colour = -1;
+}
+
+static void _forget_all_shown_cells()
+{
+    shown_cells.clear();
+}
+
+#ifdef DEBUG_CONSOLE_FRAMES
+static struct
+{
+    int frames;
+    long long cells;   // cells puttext() was given
+    long long written; // cells passed on to curses
+    long long moves;   // cursor moves between runs of written cells
+} frame_stats;
+#endif
+
 static unsigned int convert_to_curses_attr(int chattr)
 {
     switch (chattr & CHATTR_ATTRMASK)
@@ -442,6 +475,7 @@ void console_startup()
 
     // Must call refresh() for ncurses to update COLS and LINES.
     refresh();
+    _forget_all_shown_cells();
     crawl_view.init_geometry();
 
     set_mouse_enabled(false);
@@ -491,9 +525,17 @@ void putwch(ucs_t chr)
     wchar_t c = chr;
     if (!c)
         c = ' ';
+
+    int y, x;
+    getyx(stdscr, y, x);
+    const int start = y * COLS + x;
+
     // TODO: recognize unsupported characters and try to transliterate
     addnwstr(&c, 1);
 
+    getyx(stdscr, y, x);
+    _forget_shown_cells(start, max(y * COLS + x, start + 1));
+
 #ifdef USE_TILE_WEB
     ucs_t buf[2];
     buf[0] = chr;
@@ -504,20 +546,80 @@ void putwch(ucs_t chr)
 
 void puttext(int x1, int y1, const crawl_view_buffer &vbuf)
 {
+    if (shown_cells.size() != (size_t) (LINES * COLS))
+        shown_cells.assign(LINES * COLS, { 0, -1 });
+
+#ifdef USE_TILE_WEB
+    // The web client's text area is only told about cells we write.
+    const bool write_all = tiles.m_crt_mode != CRT_DISABLED;
+#else
+    const bool write_all = false;
+#endif
+
     const screen_cell_t *cell = vbuf;
     const coord_def size = vbuf.size();
     for (int y = 0; y < size.y; ++y)
     {
-        cgotoxy(x1, y1 + y);
-        for (int x = 0; x < size.x; ++x)
+        const int sy = crawl_view.termp.y + y1 + y - 2;
+        bool positioned = false;
+        for (int x = 0; x < size.x; ++x, ++cell)
         {
+            const int sx = crawl_view.termp.x + x1 + x - 2;
+            shown_cell *shown = sy < LINES && sx < COLS
+                                ? &shown_cells[sy * COLS + sx] : nullptr;
+
+            if (!write_all && shown && shown->colour == cell->colour
+                && shown->glyph == cell->glyph)
+            {
+                positioned = false;
+                continue;
+            }
+
+            if (!positioned)
+            {
+                cgotoxy(x1 + x, y1 + y);
+                positioned = true;
+#ifdef DEBUG_CONSOLE_FRAMES
+                frame_stats.moves++;
+#endif
+            }
             put_colour_ch(cell->colour, cell->glyph);
-            cell++;
+#ifdef DEBUG_CONSOLE_FRAMES
+            frame_stats.written++;
+#endif
+
+            // Wide characters spill into the next cell; leave both unknown.
+            if (shown && getcurx(stdscr) == sx + 1)
+                *shown = { cell->glyph, cell->colour };
+            else
+                positioned = false;
         }
     }
+#ifdef DEBUG_CONSOLE_FRAMES
+    frame_stats.frames++;
+    frame_stats.cells += size.x * size.y;
+#endif
     update_screen();
 }
 
+#ifdef DEBUG_CONSOLE_FRAMES
+void dump_console_frame_stats()
+{
+    FILE *f = fopen("console_frames", "w");
+    ASSERT(f);
+
+    const int frames = max(frame_stats.frames, 1);
+    fprintf(f, "%d frames\n", frame_stats.frames);
+    fprintf(f, "%lld cells, %lld per frame\n", frame_stats.cells,
+            frame_stats.cells / frames);
+    fprintf(f, "%lld written, %lld per frame\n", frame_stats.written,
+            frame_stats.written / frames);
+    fprintf(f, "%lld cursor moves, %lld per frame\n", frame_stats.moves,
+            frame_stats.moves / frames);
+    fclose(f);
+}
+#endif
+
 // These next four are front functions so that we can reduce
 // the amount of curses special code that occurs outside this
 // this file. This is good, since there are some issues with
@@ -536,6 +638,10 @@ void clear_to_end_of_line()
 {
     textcolour(LIGHTGREY);
     textbackground(BLACK);
+
+    int y, x;
+    getyx(stdscr, y, x);
+    _forget_shown_cells(y * COLS + x, (y + 1) * COLS);
     clrtoeol();
 
 #ifdef USE_TILE_WEB
@@ -563,6 +669,7 @@ void clrscr()
     textcolour(LIGHTGREY);
     textbackground(BLACK);
     clear();
+    _forget_all_shown_cells();
 #ifdef DGAMELAUNCH
     printf("%s", DGL_CLEAR_SCREEN);
     fflush(stdout);
@@ -763,6 +870,7 @@ static inline void write_char_at(int y, int x, const cchar_t &ch)
 {
     move(y, x);
     add_wchnstr(&ch, 1);
+    _forget_shown_cells(y * COLS + x, y * COLS + x + 1);
 }
 
 static void flip_colour(cchar_t &ch)
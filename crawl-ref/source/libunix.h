@@ -21,5 +21,9 @@ static inline constexpr bool is_tiles() { return false; }
 
 extern int unixcurses_get_vi_key(int keyin);
 
+#ifdef DEBUG_CONSOLE_FRAMES
+void dump_console_frame_stats();
+#endif
+
 #endif
 #endif
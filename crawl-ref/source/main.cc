@@ -553,6 +553,10 @@ static void _show_commandline_options_help()
     puts("      Defaults to entire dungeon; same level syntax as -mapstat.");
     puts("  -iters <num>        For -mapstat and -objstat, set the number of "
          "iterations");
+    puts("  -genbench [<file>]  as -mapstat, also writing level generation "
+         "speed to");
+    puts("      genbench.json and comparing it with an earlier <file>; "
+         "use with -seed");
 #endif
     puts("");
     puts("Miscellaneous options:");
@@ -2348,7 +2352,8 @@ static void _prep_input()
     textcolour(LIGHTGREY);
 
     you.redraw_status_lights = true;
-    if (!player_stair_delay())
+    // Skipped stats stay flagged for redraw and go out with the next frame.
+    if (!player_stair_delay() && !run_frame_capped())
         print_stats();
 
     viewwindow();
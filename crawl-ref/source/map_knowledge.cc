@@ -9,6 +9,7 @@
 #include "notes.h"
 #include "religion.h"
 #include "terrain.h"
+#include "travel.h"
 #ifdef USE_TILE
  #include "tilepick.h"
  #include "tileview.h"
@@ -20,6 +21,7 @@ void set_terrain_mapped(const coord_def gc)
     map_cell* cell = &env.map_knowledge(gc);
     cell->flags &= (~MAP_CHANGED_FLAG);
     cell->flags |= MAP_MAGIC_MAPPED_FLAG;
+    travel_map_changed(gc);
 #ifdef USE_TILE
     tiles.update_minimap(gc);
 #endif
@@ -108,6 +110,7 @@ void set_terrain_seen(const coord_def pos)
     if (!(cell->flags & MAP_SEEN_FLAG))
     {
         _automap_from(pos.x, pos.y, _map_quality());
+        travel_map_changed(pos);
 
         if (!is_boring_terrain(feat))
         {
@@ -145,11 +148,11 @@ void clear_terrain_visibility()
 
 void map_cell::set_detected_item()
 {
-    clear_item();
+    item_info detected;
+    detected.base_type = OBJ_DETECTED;
+    detected.rnd       = 1;
+    set_item(detected, false);
     flags |= MAP_DETECTED_ITEM;
-    _item = new item_info();
-    _item->base_type = OBJ_DETECTED;
-    _item->rnd       = 1;
 }
 
 static bool _floor_mf(map_feature mf)
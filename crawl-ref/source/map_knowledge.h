@@ -58,55 +58,147 @@ struct cloud_info
 #endif
 
 /*
- * A map_cell stores what the player knows about a cell.
- * These go in env.map_knowledge.
+ * Reference-counted, copy-on-write storage for the monster, item or cloud
+ * that a map_cell remembers. Copying a cell (into map_forgotten, or the
+ * webtiles copy of the map) only shares the payload, and updating a cell
+ * that is its payload's only owner reuses the storage in place. Blocks come
+ * from a per-type free list carved out of slabs, so that refreshing every
+ * visible cell each turn does not churn the general heap.
  */
-struct map_cell
+template <typename T>
+class cell_payload
 {
-    map_cell() : flags(0), _feat(DNGN_UNSEEN), _feat_colour(0),
-                 _trap(TRAP_UNASSIGNED), _cloud(0), _item(0), _mons(0)
+public:
+    cell_payload() : node(nullptr) { }
+
+    cell_payload(const cell_payload &other) : node(other.node)
     {
+        if (node)
+            node->refs++;
     }
 
-    map_cell(const map_cell& c)
+    ~cell_payload()
     {
-        memcpy(this, &c, sizeof(map_cell));
-        if (_cloud)
-            _cloud = new cloud_info(*_cloud);
-        if (_mons)
-            _mons = new monster_info(*_mons);
-        if (_item)
-            _item = new item_info(*_item);
+        reset();
     }
 
-    ~map_cell()
+    cell_payload &operator=(const cell_payload &other)
     {
-        if (_cloud)
-            delete _cloud;
-        if (!(flags & MAP_DETECTED_MONSTER) && _mons)
-            delete _mons;
-        if (_item)
-            delete _item;
+        if (other.node)
+            other.node->refs++;
+        reset();
+        node = other.node;
+        return *this;
     }
 
-    map_cell& operator=(const map_cell& c)
+    const T *get() const
+    {
+        return node ? &node->value : nullptr;
+    }
+
+    // Returns a value that no other cell shares, for modifying in place.
+    T *edit()
+    {
+        if (node && node->refs > 1)
+        {
+            payload_node *copy = _alloc(node->value);
+            reset();
+            node = copy;
+        }
+        return node ? &node->value : nullptr;
+    }
+
+    void set(const T &value)
+    {
+        if (node && node->refs == 1)
+            node->value = value;
+        else
+        {
+            payload_node *fresh = _alloc(value);
+            reset();
+            node = fresh;
+        }
+    }
+
+    void reset()
+    {
+        if (node && !--node->refs)
+            _free(node);
+        node = nullptr;
+    }
+
+private:
+    struct payload_node
+    {
+        payload_node(const T &v) : value(v), refs(1) { }
+
+        T value;
+        int refs;
+    };
+
+    union slot
+    {
+        slot *next;
+        alignas(payload_node) char storage[sizeof(payload_node)];
+    };
+
+    static const int SLAB_SIZE = 64;
+
+    static slot *&_free_list()
+    {
+        static slot *head = nullptr;
+        return head;
+    }
+
+    static payload_node *_alloc(const T &value)
+    {
+        slot *&head = _free_list();
+        if (!head)
+        {
+            // Slabs are never returned; they are reused for the rest of the
+            // process.
+            slot *slab = new slot[SLAB_SIZE];
+            for (int i = 0; i < SLAB_SIZE - 1; ++i)
+                slab[i].next = &slab[i + 1];
+            slab[SLAB_SIZE - 1].next = nullptr;
+            head = slab;
+        }
+
+        slot *block = head;
+        head = block->next;
+        try
+        {
+            return new (block->storage) payload_node(value);
+        }
+        catch (...)
+        {
+            block->next = head;
+            head = block;
+            throw;
+        }
+    }
+
+    static void _free(payload_node *pn)
+    {
+        pn->~payload_node();
+        slot *block = reinterpret_cast<slot *>(pn);
+        slot *&head = _free_list();
+        block->next = head;
+        head = block;
+    }
+
+    payload_node *node;
+};
+
+/*
+ * A map_cell stores what the player knows about a cell.
+ * These go in env.map_knowledge.
+ */
+struct map_cell
+{
+    map_cell() : flags(0), _feat(DNGN_UNSEEN), _feat_colour(0),
+                 _trap(TRAP_UNASSIGNED), _cloud(), _item(), _mons()
     {
-        if (&c == this)
-            return *this;
-        if (_cloud)
-            delete _cloud;
-        if (_mons)
-            delete _mons;
-        if (_item)
-            delete _item;
-        memcpy(this, &c, sizeof(map_cell));
-        if (_cloud)
-            _cloud = new cloud_info(*_cloud);
-        if (_mons)
-            _mons = new monster_info(*_mons);
-        if (_item)
-            _item = new item_info(*_item);
-        return *this;
     }
 
     void clear()
@@ -144,16 +236,21 @@ struct map_cell
         _trap = tr;
     }
 
-    item_info* item() const
+    const item_info* item() const
     {
-        return _item;
+        return _item.get();
+    }
+
+    item_info* edit_item()
+    {
+        return _item.edit();
     }
 
     bool detected_item() const
     {
         const bool ret = !!(flags & MAP_DETECTED_ITEM);
         // TODO: change to an ASSERT when the underlying crash goes away
-        if (ret && !_item)
+        if (ret && !_item.get())
         {
             //clear_item();
             return false;
@@ -163,8 +260,8 @@ struct map_cell
 
     void set_item(const item_info& ii, bool more_items)
     {
-        clear_item();
-        _item = new item_info(ii);
+        flags &= ~(MAP_DETECTED_ITEM | MAP_MORE_ITEMS);
+        _item.set(ii);
         if (more_items)
             flags |= MAP_MORE_ITEMS;
     }
@@ -173,31 +270,32 @@ struct map_cell
 
     void clear_item()
     {
-        if (_item)
-        {
-            delete _item;
-            _item = 0;
-        }
+        _item.reset();
         flags &= ~(MAP_DETECTED_ITEM | MAP_MORE_ITEMS);
     }
 
     monster_type monster() const
     {
-        if (_mons)
-            return _mons->type;
+        if (const monster_info *mi = _mons.get())
+            return mi->type;
         else
             return MONS_NO_MONSTER;
     }
 
-    monster_info* monsterinfo() const
+    const monster_info* monsterinfo() const
+    {
+        return _mons.get();
+    }
+
+    monster_info* edit_monsterinfo()
     {
-        return _mons;
+        return _mons.edit();
     }
 
     void set_monster(const monster_info& mi)
     {
-        clear_monster();
-        _mons = new monster_info(mi);
+        flags &= ~(MAP_DETECTED_MONSTER | MAP_INVISIBLE_MONSTER);
+        _mons.set(mi);
     }
 
     bool detected_monster() const
@@ -212,9 +310,9 @@ struct map_cell
 
     void set_detected_monster(monster_type mons)
     {
-        clear_monster();
-        _mons = new monster_info(MONS_SENSED);
-        _mons->base_type = mons;
+        monster_info mi(MONS_SENSED);
+        mi.base_type = mons;
+        set_monster(mi);
         flags |= MAP_DETECTED_MONSTER;
     }
 
@@ -226,47 +324,44 @@ struct map_cell
 
     void clear_monster()
     {
-        if (_mons)
-            delete _mons;
+        _mons.reset();
         flags &= ~(MAP_DETECTED_MONSTER | MAP_INVISIBLE_MONSTER);
-        _mons = 0;
     }
 
     cloud_type cloud() const
     {
-        if (_cloud)
-            return _cloud->type;
+        if (const cloud_info *ci = _cloud.get())
+            return ci->type;
         else
             return CLOUD_NONE;
     }
 
     unsigned cloud_colour() const
     {
-        if (_cloud)
-            return _cloud->colour;
+        if (const cloud_info *ci = _cloud.get())
+            return ci->colour;
         else
             return 0;
     }
 
-    cloud_info* cloudinfo() const
+    const cloud_info* cloudinfo() const
     {
-        return _cloud;
+        return _cloud.get();
+    }
+
+    cloud_info* edit_cloudinfo()
+    {
+        return _cloud.edit();
     }
 
     void set_cloud(const cloud_info& ci)
     {
-        if (_cloud)
-            delete _cloud;
-        _cloud = new cloud_info(ci);
+        _cloud.set(ci);
     }
 
     void clear_cloud()
     {
-        if (_cloud)
-        {
-            delete _cloud;
-            _cloud = 0;
-        }
+        _cloud.reset();
     }
 
     bool known() const
@@ -305,9 +400,9 @@ private:
     dungeon_feature_type _feat:8;
     colour_t _feat_colour;
     trap_type _trap:8;
-    cloud_info* _cloud;
-    item_info* _item;
-    monster_info* _mons;
+    cell_payload<cloud_info> _cloud;
+    cell_payload<item_info> _item;
+    cell_payload<monster_info> _mons;
 };
 
 void set_terrain_mapped(const coord_def c);
@@ -0,0 +1,337 @@
+/**
+ * @file
+ * @brief Read-only, memory-mapped dbm for the text databases.
+**/
+
+#include "AppHdr.h"
+
+#include "mapdbm.h"
+
+#ifdef USE_MAPPED_DBM
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "end.h"
+#include "hash.h"
+#include "syscalls.h"
+
+// The file is a header, then nbuckets bucket slots, then nentries entries,
+// then the keys and values they point at. It is only ever read by the
+// build that wrote it, so everything is in native byte order.
+
+static const char MAPDBM_MAGIC[8] = { 'C', 'R', 'A', 'W', 'L', 'D', 'B', 1 };
+
+struct mapdbm_header
+{
+    char magic[8];
+    uint32_t nentries;
+    uint32_t nbuckets;  // a power of two, more than nentries
+};
+
+// Buckets hold one more than the index of their entry, or 0 if empty.
+// Collisions probe the following buckets.
+
+struct MAP_DBM::entry
+{
+    uint32_t hash;
+    uint32_t key_offset;
+    uint32_t key_size;
+    uint32_t value_offset;
+    uint32_t value_size;
+};
+
+static uint32_t _key_hash(const char *key, size_t size)
+{
+    return hash32(key, size);
+}
+
+MAP_DBM::MAP_DBM(const string &dbname, bool _readonly)
+    : iterator(0), dbfile(dbname), readonly(_readonly), map(nullptr),
+      map_size(0), nentries(0), nbuckets(0)
+{
+    if (dbfile.find(".db") != dbfile.length() - 3)
+        dbfile += ".db";
+
+    if (!readonly)
+        return;
+
+    const int fd = open_u(dbfile.c_str(), O_RDONLY, 0);
+    if (fd == -1)
+        return;
+
+    struct stat st;
+    if (fstat(fd, &st) || (size_t) st.st_size < sizeof(mapdbm_header))
+    {
+        close(fd);
+        return;
+    }
+
+    void *mem = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED)
+        return;
+
+    map = (char *) mem;
+    map_size = st.st_size;
+
+    // Anything that doesn't look right (an old SQLite db, a truncated
+    // file) counts as not being there, so that it gets rebuilt.
+    const mapdbm_header *header = (const mapdbm_header *) map;
+    const uint64_t tables = sizeof(mapdbm_header)
+                            + (uint64_t) header->nbuckets * sizeof(uint32_t)
+                            + (uint64_t) header->nentries * sizeof(entry);
+    bool valid = !memcmp(header->magic, MAPDBM_MAGIC, sizeof(MAPDBM_MAGIC))
+                 && header->nbuckets > header->nentries
+                 && !(header->nbuckets & (header->nbuckets - 1))
+                 && tables <= map_size;
+    if (valid)
+    {
+        nentries = header->nentries;
+        nbuckets = header->nbuckets;
+        const entry *entries = _entries();
+        for (uint32_t i = 0; valid && i < nentries; ++i)
+        {
+            valid = (uint64_t) entries[i].key_offset + entries[i].key_size
+                        <= map_size
+                    && (uint64_t) entries[i].value_offset
+                       + entries[i].value_size <= map_size;
+        }
+
+        // Every bucket must name a real entry or be empty, and there must
+        // be an empty one for a failed lookup to stop at.
+        const uint32_t *buckets =
+            (const uint32_t *) (map + sizeof(mapdbm_header));
+        bool have_empty = false;
+        for (uint32_t b = 0; valid && b < nbuckets; ++b)
+        {
+            valid = buckets[b] <= nentries;
+            have_empty = have_empty || !buckets[b];
+        }
+        valid = valid && have_empty;
+    }
+
+    if (!valid)
+    {
+        munmap(map, map_size);
+        map = nullptr;
+        map_size = nentries = nbuckets = 0;
+    }
+}
+
+MAP_DBM::~MAP_DBM()
+{
+    if (map)
+        munmap(map, map_size);
+}
+
+bool MAP_DBM::is_open() const
+{
+    return !readonly || map;
+}
+
+const MAP_DBM::entry *MAP_DBM::_entries() const
+{
+    return (const entry *) (map + sizeof(mapdbm_header)
+                            + nbuckets * sizeof(uint32_t));
+}
+
+map_datum MAP_DBM::_data(uint32_t offset, uint32_t size) const
+{
+    map_datum result;
+    result.dptr = map + offset;
+    result.dsize = size;
+    return result;
+}
+
+map_datum MAP_DBM::fetch(const map_datum &key) const
+{
+    map_datum result;
+    result.dptr = nullptr;
+    result.dsize = 0;
+
+    if (!readonly)
+    {
+        auto found = pending_index.find(string(key.dptr, key.dsize));
+        if (found != pending_index.end())
+        {
+            const string &value = pending[found->second].second;
+            result.dptr = const_cast<char *>(value.data());
+            result.dsize = value.size();
+        }
+        return result;
+    }
+
+    if (!nbuckets)
+        return result;
+
+    const uint32_t *buckets =
+        (const uint32_t *) (map + sizeof(mapdbm_header));
+    const entry *entries = _entries();
+    const uint32_t hash = _key_hash(key.dptr, key.dsize);
+    uint32_t b = hash & (nbuckets - 1);
+    for (uint32_t probes = 0; probes < nbuckets && buckets[b];
+         ++probes, b = (b + 1) & (nbuckets - 1))
+    {
+        const entry &e = entries[buckets[b] - 1];
+        if (e.hash == hash && e.key_size == key.dsize
+            && !memcmp(map + e.key_offset, key.dptr, key.dsize))
+        {
+            return _data(e.value_offset, e.value_size);
+        }
+    }
+    return result;
+}
+
+map_datum MAP_DBM::key(size_t i) const
+{
+    map_datum result;
+    result.dptr = nullptr;
+    result.dsize = 0;
+
+    if (!readonly)
+    {
+        if (i < pending.size())
+        {
+            result.dptr = const_cast<char *>(pending[i].first.data());
+            result.dsize = pending[i].first.size();
+        }
+    }
+    else if (i < nentries)
+        result = _data(_entries()[i].key_offset, _entries()[i].key_size);
+    return result;
+}
+
+void MAP_DBM::store(const map_datum &key, const map_datum &value)
+{
+    ASSERT(!readonly);
+    string k(key.dptr, key.dsize);
+    auto found = pending_index.find(k);
+    if (found != pending_index.end())
+        pending[found->second].second.assign(value.dptr, value.dsize);
+    else
+    {
+        pending_index[k] = pending.size();
+        pending.emplace_back(k, string(value.dptr, value.dsize));
+    }
+}
+
+// Write out what was stored, if opened for writing.
+void MAP_DBM::flush() const
+{
+    if (readonly)
+        return;
+
+    if (!_write())
+        end(1, true, "Unable to write DB: %s", dbfile.c_str());
+}
+
+// Write the entries out to a temporary file and move it into place, so
+// that processes that have the old file mapped keep seeing all of it.
+bool MAP_DBM::_write() const
+{
+    mapdbm_header header;
+    memcpy(header.magic, MAPDBM_MAGIC, sizeof(MAPDBM_MAGIC));
+    header.nentries = pending.size();
+    header.nbuckets = 1;
+    // Keep the table at most half full.
+    while (header.nbuckets < 2 * header.nentries + 1)
+        header.nbuckets *= 2;
+
+    vector<uint32_t> buckets(header.nbuckets, 0);
+    vector<entry> entries(header.nentries);
+    uint64_t offset = sizeof(header)
+                      + (uint64_t) header.nbuckets * sizeof(uint32_t)
+                      + (uint64_t) header.nentries * sizeof(entry);
+    for (uint32_t i = 0; i < header.nentries; ++i)
+    {
+        const string &k = pending[i].first;
+        const string &v = pending[i].second;
+        entry &e = entries[i];
+        e.hash = _key_hash(k.data(), k.size());
+        e.key_offset = offset;
+        e.key_size = k.size();
+        offset += k.size();
+        e.value_offset = offset;
+        e.value_size = v.size();
+        offset += v.size();
+
+        uint32_t b = e.hash & (header.nbuckets - 1);
+        while (buckets[b])
+            b = (b + 1) & (header.nbuckets - 1);
+        buckets[b] = i + 1;
+    }
+    if (offset > UINT32_MAX)
+        return false;
+
+    const string tmpfile = dbfile + ".tmp";
+    FILE *f = fopen_u(tmpfile.c_str(), "wb");
+    if (!f)
+        return false;
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1
+              && fwrite(buckets.data(), sizeof(uint32_t), buckets.size(), f)
+                 == buckets.size()
+              && fwrite(entries.data(), sizeof(entry), entries.size(), f)
+                 == entries.size();
+    for (const auto &kv : pending)
+    {
+        ok = ok && fwrite(kv.first.data(), 1, kv.first.size(), f)
+                   == kv.first.size()
+                && fwrite(kv.second.data(), 1, kv.second.size(), f)
+                   == kv.second.size();
+    }
+    ok = !fclose(f) && ok && !rename_u(tmpfile.c_str(), dbfile.c_str());
+
+    if (!ok)
+        unlink_u(tmpfile.c_str());
+    return ok;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+MAP_DBM *dbm_open(const char *filename, int mode, int)
+{
+    MAP_DBM *n = new MAP_DBM(filename, mode == O_RDONLY);
+    if (!n->is_open())
+    {
+        delete n;
+        return nullptr;
+    }
+
+    return n;
+}
+
+int dbm_close(MAP_DBM *db)
+{
+    db->flush();
+    delete db;
+    return 0;
+}
+
+map_datum dbm_fetch(MAP_DBM *db, const map_datum &key)
+{
+    return db->fetch(key);
+}
+
+map_datum dbm_firstkey(MAP_DBM *db)
+{
+    db->iterator = 0;
+    return dbm_nextkey(db);
+}
+
+map_datum dbm_nextkey(MAP_DBM *db)
+{
+    return db->key(db->iterator++);
+}
+
+int dbm_store(MAP_DBM *db, const map_datum &key, const map_datum &value, int)
+{
+    db->store(key, value);
+    return 0;
+}
+
+#endif // USE_MAPPED_DBM
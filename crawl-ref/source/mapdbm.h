@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @brief Read-only, memory-mapped dbm for the text databases.
+**/
+
+#ifndef MAPDBM_H
+#define MAPDBM_H
+
+#ifdef USE_MAPPED_DBM
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A dbm interface over an immutable file holding a hash table of keys and
+// values, mapped read-only so that every process using it shares the same
+// pages. Opening with O_RDWR instead collects entries in memory, which are
+// written out (replacing any old file) on dbm_close.
+
+struct map_datum
+{
+    char   *dptr;
+    size_t dsize;
+};
+
+#define DBM_REPLACE 1
+
+class MAP_DBM
+{
+public:
+    MAP_DBM(const string &db, bool readonly);
+    ~MAP_DBM();
+
+    bool is_open() const;
+
+    map_datum fetch(const map_datum &key) const;
+    map_datum key(size_t i) const;
+    void store(const map_datum &key, const map_datum &value);
+    void flush() const;
+
+public:
+    // dbm_firstkey() and dbm_nextkey() iterate in the order of store().
+    size_t iterator;
+
+private:
+    struct entry;
+    map_datum _data(uint32_t offset, uint32_t size) const;
+    const entry *_entries() const;
+    bool _write() const;
+
+private:
+    string dbfile;
+    bool readonly;
+
+    // Read-only: the mapped file.
+    char *map;
+    size_t map_size;
+    uint32_t nentries;
+    uint32_t nbuckets;
+
+    // Writable: what to write on closing.
+    vector<pair<string, string>> pending;
+    unordered_map<string, size_t> pending_index;
+};
+
+MAP_DBM  *dbm_open(const char *filename, int open_mode, int permissions);
+int   dbm_close(MAP_DBM *db);
+
+map_datum dbm_fetch(MAP_DBM *db, const map_datum &key);
+map_datum dbm_firstkey(MAP_DBM *db);
+map_datum dbm_nextkey(MAP_DBM *db);
+int dbm_store(MAP_DBM *db, const map_datum &key,
+              const map_datum &value, int overwrite);
+
+typedef map_datum datum;
+typedef MAP_DBM DBM;
+
+#endif
+
+#endif
@@ -10,7 +10,6 @@
 #include <algorithm>
 
 #include "cluautil.h"
-#include "coordit.h"
 #include "dlua.h"
 #include "end.h"
 #include "env.h"
@@ -528,6 +527,16 @@ string map_wiz_props_marker::property(const string &pname) const
     return lookup(properties, pname, "");
 }
 
+vector<string> map_wiz_props_marker::property_names() const
+{
+    vector<string> names;
+    for (const auto &entry : properties)
+        names.push_back(entry.first);
+    if (properties.count("feature_description"))
+        names.emplace_back("desc");
+    return names;
+}
+
 string map_wiz_props_marker::set_property(const string &key, const string &val)
 {
     string old_val = properties[key];
@@ -943,11 +952,13 @@ string map_position_marker::debug_describe() const
 
 map_markers::map_markers() : markers(), have_inactive_markers(false)
 {
+    cell_markers.init(0);
 }
 
 map_markers::map_markers(const map_markers &c)
   : markers(), have_inactive_markers(false)
 {
+    cell_markers.init(0);
     init_from(c);
 }
 
@@ -1011,9 +1022,62 @@ void map_markers::activate_markers_at(coord_def p)
     }
 }
 
+static bool _on_grid(const coord_def &c)
+{
+    return c.x >= 0 && c.x < GXM && c.y >= 0 && c.y < GYM;
+}
+
+void map_markers::index_marker(map_marker *marker)
+{
+    if (_on_grid(marker->pos))
+        ++cell_markers(marker->pos);
+
+    if (!marker->has_static_properties())
+        dynamic_markers.insert(marker);
+    else
+    {
+        for (const string &name : marker->property_names())
+            prop_index.emplace(name, marker);
+    }
+}
+
+void map_markers::unindex_marker(const map_marker *marker)
+{
+    if (_on_grid(marker->pos))
+        --cell_markers(marker->pos);
+
+    if (!marker->has_static_properties())
+    {
+        dynamic_markers.erase(const_cast<map_marker *>(marker));
+        return;
+    }
+
+    // Properties are only ever added, so these cover every name it was
+    // indexed under.
+    for (const string &name : marker->property_names())
+    {
+        auto range = prop_index.equal_range(name);
+        for (auto i = range.first; i != range.second;)
+        {
+            if (i->second == marker)
+                i = prop_index.erase(i);
+            else
+                ++i;
+        }
+    }
+}
+
+// True if c certainly has no markers; markers placed off the grid are
+// only found through the marker map.
+bool map_markers::no_markers_at(const coord_def &c) const
+{
+    return _on_grid(c) && !cell_markers(c);
+}
+
 void map_markers::add(map_marker *marker)
 {
     markers.insert(dgn_pos_marker(marker->pos, marker));
+    index_marker(marker);
     have_inactive_markers = true;
 }
 
@@ -1024,6 +1088,7 @@ void map_markers::unlink_marker(const map_marker *marker)
     {
         if (i->second == marker)
         {
+            unindex_marker(marker);
             markers.erase(i);
             break;
         }
@@ -1046,12 +1111,16 @@ void map_markers::remove(map_marker *marker)
 void map_markers::remove_markers_at(const coord_def &c,
                                     map_marker_type type)
 {
+    if (no_markers_at(c))
+        return;
+
     auto els = markers.equal_range(c);
     for (auto i = els.first; i != els.second;)
     {
         auto todel = i++;
         if (type == MAT_ANY || todel->second->get_type() == type)
         {
+            unindex_marker(todel->second);
             delete todel->second;
             markers.erase(todel);
         }
@@ -1061,6 +1130,9 @@ void map_markers::remove_markers_at(const coord_def &c,
 
 map_marker *map_markers::find(const coord_def &c, map_marker_type type)
 {
+    if (no_markers_at(c))
+        return nullptr;
+
     auto els = markers.equal_range(c);
     for (auto i = els.first; i != els.second; ++i)
         if (type == MAT_ANY || i->second->get_type() == type)
@@ -1087,6 +1159,7 @@ void map_markers::move(const coord_def &from, const coord_def &to)
     {
         auto curr = i++;
         tmarkers.push_back(curr->second);
+        unindex_marker(curr->second);
         markers.erase(curr);
     }
 
@@ -1116,17 +1189,34 @@ vector<map_marker*> map_markers::get_all(map_marker_type mat)
     return rmarkers;
 }
 
+set<coord_def> map_markers::property_positions(const string &key) const
+{
+    set<coord_def> where;
+    auto els = prop_index.equal_range(key);
+    for (auto i = els.first; i != els.second; ++i)
+        where.insert(i->second->pos);
+    for (const map_marker *marker : dynamic_markers)
+        where.insert(marker->pos);
+    return where;
+}
+
 vector<map_marker*> map_markers::get_all(const string &key, const string &val)
 {
     vector<map_marker*> rmarkers;
 
-    for (const auto &entry : markers)
+    // Only cells with a marker that might have the property need asking.
+    // Markers at those cells without it answer "", as before.
+    for (const coord_def &c : property_positions(key))
     {
-        map_marker*  marker = entry.second;
-        const string prop   = marker->property(key);
+        auto els = markers.equal_range(c);
+        for (auto i = els.first; i != els.second; ++i)
+        {
+            map_marker*  marker = i->second;
+            const string prop   = marker->property(key);
 
-        if (val.empty() && !prop.empty() || !val.empty() && val == prop)
-            rmarkers.push_back(marker);
+            if (val.empty() && !prop.empty() || !val.empty() && val == prop)
+                rmarkers.push_back(marker);
+        }
     }
 
     return rmarkers;
@@ -1134,8 +1224,11 @@ vector<map_marker*> map_markers::get_all(const string &key, const string &val)
 
 vector<map_marker*> map_markers::get_markers_at(const coord_def &c)
 {
-    auto els = markers.equal_range(c);
     vector<map_marker*> rmarkers;
+    if (no_markers_at(c))
+        return rmarkers;
+
+    auto els = markers.equal_range(c);
     for (auto i = els.first; i != els.second; ++i)
         rmarkers.push_back(i->second);
     return rmarkers;
@@ -1144,6 +1237,9 @@ vector<map_marker*> map_markers::get_markers_at(const coord_def &c)
 string map_markers::property_at(const coord_def &c, map_marker_type type,
                                 const string &key)
 {
+    if (no_markers_at(c))
+        return "";
+
     auto els = markers.equal_range(c);
     for (auto i = els.first; i != els.second; ++i)
     {
@@ -1159,6 +1255,9 @@ void map_markers::clear()
     for (auto &entry : markers)
         delete entry.second;
     markers.clear();
+    cell_markers.init(0);
+    prop_index.clear();
+    dynamic_markers.clear();
     check_empty();
 }
 
@@ -1208,6 +1307,22 @@ bool marker_vetoes_operation(const char *op)
     return env.markers.property_at(you.pos(), MAT_ANY, op) == "veto";
 }
 
+// The on-grid positions among where, in the order a rectangle_iterator
+// over the whole map would visit them.
+static vector<coord_def> _by_rows(const set<coord_def> &where)
+{
+    vector<coord_def> rows;
+    for (const coord_def &c : where)
+        if (_on_grid(c))
+            rows.push_back(c);
+    sort(rows.begin(), rows.end(),
+         [](const coord_def &a, const coord_def &b)
+         {
+             return a.y < b.y || a.y == b.y && a.x < b.x;
+         });
+    return rows;
+}
+
 coord_def find_marker_position_by_prop(const string &prop,
                                        const string &expected)
 {
@@ -1226,12 +1341,12 @@ vector<coord_def> find_marker_positions_by_prop(const string &prop,
                                                 unsigned maxresults)
 {
     vector<coord_def> marker_positions;
-    for (rectangle_iterator i(0, 0); i; ++i)
+    for (const coord_def &c : _by_rows(env.markers.property_positions(prop)))
     {
-        const string value = env.markers.property_at(*i, MAT_ANY, prop);
+        const string value = env.markers.property_at(c, MAT_ANY, prop);
         if (!value.empty() && (expected.empty() || value == expected))
         {
-            marker_positions.push_back(*i);
+            marker_positions.push_back(c);
             if (maxresults && marker_positions.size() >= maxresults)
                 return marker_positions;
         }
@@ -1244,9 +1359,9 @@ vector<map_marker*> find_markers_by_prop(const string &prop,
                                          unsigned maxresults)
 {
     vector<map_marker*> markers;
-    for (rectangle_iterator pos(0, 0); pos; ++pos)
+    for (const coord_def &pos : _by_rows(env.markers.property_positions(prop)))
     {
-        for (map_marker *mark : env.markers.get_markers_at(*pos))
+        for (map_marker *mark : env.markers.get_markers_at(pos))
         {
             const string value(mark->property(prop));
             if (!value.empty() && (expected.empty() || value == expected))
@@ -60,6 +60,13 @@ public:
     virtual string debug_describe() const = 0;
     virtual string property(const string &pname) const;
 
+    // Markers whose properties are fixed once they are placed report the
+    // names of those properties, so that map_markers can index them.
+    // Markers that compute properties on the fly return false from
+    // has_static_properties() and are always asked directly.
+    virtual bool has_static_properties() const { return true; }
+    virtual vector<string> property_names() const { return {}; }
+
     static map_marker *read_marker(reader &);
     /// @throws bad_map_marker if text could not be parsed.
     static map_marker *parse_marker(const string &text, const string &ctx = "");
@@ -273,6 +280,7 @@ public:
     map_marker *clone() const override;
     string debug_describe() const override;
     string property(const string &pname) const override;
+    bool has_static_properties() const override { return false; }
 
     bool notify_dgn_event(const dgn_event &e) override;
 
@@ -302,6 +310,8 @@ public:
     void read(reader &) override;
     string debug_describe() const override;
     string property(const string &pname) const override;
+    vector<string> property_names() const override;
+    // Properties must be set before the marker is added to env.markers.
     string set_property(const string &key, const string &val);
     map_marker *clone() const override;
     static map_marker *read(reader &, map_marker_type);
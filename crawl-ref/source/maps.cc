@@ -8,6 +8,7 @@
 #include "maps.h"
 
 #include <algorithm>
+#include <bitset>
 #include <cstdlib>
 #include <cstring>
 #include <sys/param.h>
@@ -158,10 +159,21 @@ static void _dgn_flush_map_environment_for(const string &mapname)
 // and validate the map
 static bool _resolve_map_lua(map_def &map)
 {
+#ifdef DEBUG_STATISTICS
+    const auto lua_start = chrono::steady_clock::now();
+#endif
     _dgn_flush_map_environment_for(map.name);
     map.reinit();
 
     string err = map.run_lua(true);
+#ifdef DEBUG_STATISTICS
+    if (crawl_state.map_stat_gen)
+    {
+        mapstat_report_map_lua_time(map,
+            chrono::duration_cast<chrono::microseconds>(
+                chrono::steady_clock::now() - lua_start));
+    }
+#endif
     if (!err.empty())
     {
 #ifdef DEBUG_STATISTICS
@@ -397,6 +409,77 @@ static bool _is_portal_place(const coord_def &c)
     return marker->property("portal") != "";
 }
 
+// The map tags that decide which cells a vault may be placed over.
+struct vault_cell_rules
+{
+    bool water_ok;
+    bool overwrite_floor_cell;
+    bool replace_portal;
+
+    vault_cell_rules(const map_def &map)
+        : water_ok(map.has_tag("water_ok") || player_in_branch(BRANCH_SWAMP)),
+          overwrite_floor_cell(map.has_tag("overwrite_floor_cell")),
+          replace_portal(map.has_tag("replace_portal"))
+    {
+    }
+};
+
+// Can a non-blank cell of a vault following these rules be placed at cp?
+static bool _vault_may_cover(const coord_def &cp, const vault_cell_rules &rules)
+{
+    // Unconditionally allow portal placements to work.
+    if (rules.replace_portal && _is_portal_place(cp))
+        return true;
+
+    if (!rules.overwrite_floor_cell)
+    {
+        // Also check adjacent squares for collisions, because being next
+        // to another vault may block off one of this vault's exits.
+        for (adjacent_iterator ai(cp); ai; ++ai)
+        {
+            if (map_bounds(*ai) && (env.level_map_mask(*ai) & MMT_VAULT))
+                return false;
+        }
+    }
+    else if (grd(cp) != DNGN_FLOOR || env.pgrid(cp) & FPROP_NO_TELE_INTO)
+    {
+        // Don't place overwrite_floor_cell vaults on anything but floor or
+        // on squares that can't be teleported into, because
+        // overwrite_floor_cell is used for things that are expected to be
+        // connected.
+        return false;
+    }
+
+    // Don't overwrite features other than floor, rock wall, doors,
+    // nor water, if !water_ok.
+    if (!_may_overwrite_feature(cp, rules.water_ok))
+        return false;
+
+    // Don't overwrite monsters or items, either!
+    if (monster_at(cp) || igrd(cp) != NON_ITEM)
+        return false;
+
+    // If in Slime, don't let stairs end up next to minivaults,
+    // so that they don't possibly end up next to unsafe walls.
+    if (player_in_branch(BRANCH_SLIME))
+    {
+        for (adjacent_iterator ai(cp); ai; ++ai)
+        {
+            if (map_bounds(*ai) && feat_is_stair(grd(*ai)))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// Would a minivault cell at c keep the vault from being isolated?
+static bool _minivault_connects_at(const coord_def &c, const map_def &map)
+{
+    return _may_overwrite_feature(c, false, false)
+           || map.has_tag("replace_portal") && _is_portal_place(c);
+}
+
 static bool _map_safe_vault_place(const map_def &map,
                                   const coord_def &c,
                                   const coord_def &size)
@@ -408,15 +491,7 @@ static bool _map_safe_vault_place(const map_def &map,
     if (map.is_overwritable_layout())
         return true;
 
-    const bool water_ok =
-        map.has_tag("water_ok") || player_in_branch(BRANCH_SWAMP);
-
-    const bool vault_can_overwrite_other_vaults =
-        map.has_tag("overwrite_floor_cell");
-
-    const bool vault_can_replace_portals =
-        map.has_tag("replace_portal");
-
+    const vault_cell_rules rules(map);
     const vector<string> &lines = map.map.get_lines();
     for (rectangle_iterator ri(c, c + size - 1); ri; ++ri)
     {
@@ -426,48 +501,8 @@ static bool _map_safe_vault_place(const map_def &map,
         if (lines[dp.y][dp.x] == ' ')
             continue;
 
-        // Unconditionally allow portal placements to work.
-        if (vault_can_replace_portals && _is_portal_place(cp))
-            continue;
-
-        if (!vault_can_overwrite_other_vaults)
-        {
-            // Also check adjacent squares for collisions, because being next
-            // to another vault may block off one of this vault's exits.
-            for (adjacent_iterator ai(cp); ai; ++ai)
-            {
-                if (map_bounds(*ai) && (env.level_map_mask(*ai) & MMT_VAULT))
-                    return false;
-            }
-        }
-        else if (grd(cp) != DNGN_FLOOR || env.pgrid(cp) & FPROP_NO_TELE_INTO)
-        {
-            // Don't place overwrite_floor_cell vaults on anything but floor or
-            // on squares that can't be teleported into, because
-            // overwrite_floor_cell is used for things that are expected to be
-            // connected.
+        if (!_vault_may_cover(cp, rules))
             return false;
-        }
-
-        // Don't overwrite features other than floor, rock wall, doors,
-        // nor water, if !water_ok.
-        if (!_may_overwrite_feature(cp, water_ok))
-            return false;
-
-        // Don't overwrite monsters or items, either!
-        if (monster_at(cp) || igrd(cp) != NON_ITEM)
-            return false;
-
-        // If in Slime, don't let stairs end up next to minivaults,
-        // so that they don't possibly end up next to unsafe walls.
-        if (player_in_branch(BRANCH_SLIME))
-        {
-            for (adjacent_iterator ai(cp); ai; ++ai)
-            {
-                if (map_bounds(*ai) && feat_is_stair(grd(*ai)))
-                    return false;
-            }
-        }
     }
 
     return true;
@@ -489,12 +524,8 @@ static bool _connected_minivault_place(const coord_def &c,
         if (lines[ci.y - c.y][ci.x - c.x] == ' ')
             continue;
 
-        if (_may_overwrite_feature(ci, false, false)
-            || (place.map.has_tag("replace_portal")
-                && _is_portal_place(ci)))
-        {
+        if (_minivault_connects_at(ci, place.map))
             return true;
-        }
     }
 
     return false;
@@ -525,29 +556,17 @@ coord_def find_portal_place(const vault_placement *place, bool check_place)
     return coord_def();
 }
 
-static coord_def _find_minivault_place(
-    const vault_placement &place,
-    bool check_place)
+// Pick random spots until one passes map_place_valid().
+static coord_def _random_minivault_place(const vault_placement &place,
+                                         int margin)
 {
-    if (place.map.has_tag("replace_portal"))
-    {
-        coord_def portal_place = find_portal_place(&place, check_place);
-        if (!portal_place.origin())
-            return portal_place;
-    }
-
-    // [ds] The margin around the edges of the map where the minivault
-    // won't be placed. Purely arbitrary as far as I can see.
-    // The spotty connector in the Shoals needs one more space to work.
-    const int margin = MAPGEN_BORDER * 2 + player_in_branch(BRANCH_SHOALS);
-
     // Find a target area which can be safely overwritten.
     for (int tries = 0; tries < 600; ++tries)
     {
         coord_def v1(random_range(margin, GXM - margin - place.size.x),
                      random_range(margin, GYM - margin - place.size.y));
 
-        if (check_place && !map_place_valid(place.map, v1, place.size))
+        if (!map_place_valid(place.map, v1, place.size))
         {
 #ifdef DEBUG_MINIVAULT_PLACEMENT
             mprf(MSGCH_DIAGNOSTICS,
@@ -571,6 +590,99 @@ static coord_def _find_minivault_place(
     return coord_def(-1, -1);
 }
 
+typedef bitset<GXM> placement_row;
+
+/**
+ * List every top-left corner at which a minivault could go, i.e. every
+ * spot that passes _map_safe_vault_place() (if check_place is set) and
+ * _connected_minivault_place().
+ *
+ * Rather than checking each cell of the vault at each spot, mark the cells
+ * the vault may cover and the cells that would connect it once for the
+ * whole level, then test each spot a row at a time by shifting those
+ * against the vault's own rows of non-blank cells.
+ */
+static vector<coord_def> _minivault_origins(const vault_placement &place,
+                                            bool check_place, int margin)
+{
+    vector<coord_def> origins;
+    const coord_def size = place.size;
+    if (size.x > GXM - 2 * margin || size.y > GYM - 2 * margin)
+        return origins;
+
+    const bool any_cell = !check_place || size.zero()
+                          || place.map.is_overwritable_layout();
+    const vault_cell_rules rules(place.map);
+
+    FixedVector<placement_row, GYM> blocked;
+    FixedVector<placement_row, GYM> connects;
+    for (rectangle_iterator ri(0); ri; ++ri)
+    {
+        if (!any_cell && !_vault_may_cover(*ri, rules))
+            blocked[ri->y].set(ri->x);
+        if (_minivault_connects_at(*ri, place.map))
+            connects[ri->y].set(ri->x);
+    }
+
+    const vector<string> &lines = place.map.map.get_lines();
+    vector<placement_row> footprint(size.y);
+    for (int y = 0; y < size.y; ++y)
+        for (int x = 0; x < size.x; ++x)
+            if (lines[y][x] != ' ')
+                footprint[y].set(x);
+
+    for (int y = margin; y <= GYM - margin - size.y; ++y)
+        for (int x = margin; x <= GXM - margin - size.x; ++x)
+        {
+            bool safe = true;
+            bool connected = size.zero();
+            for (int row = 0; row < size.y && safe; ++row)
+            {
+                safe = ((blocked[y + row] >> x) & footprint[row]).none();
+                connected = connected
+                            || ((connects[y + row] >> x)
+                                & footprint[row]).any();
+            }
+
+            if (safe && connected)
+                origins.emplace_back(x, y);
+        }
+
+    return origins;
+}
+
+static coord_def _find_minivault_place(
+    const vault_placement &place,
+    bool check_place)
+{
+    if (place.map.has_tag("replace_portal"))
+    {
+        coord_def portal_place = find_portal_place(&place, check_place);
+        if (!portal_place.origin())
+            return portal_place;
+    }
+
+    // [ds] The margin around the edges of the map where the minivault
+    // won't be placed. Purely arbitrary as far as I can see.
+    // The spotty connector in the Shoals needs one more space to work.
+    const int margin = MAPGEN_BORDER * 2 + player_in_branch(BRANCH_SHOALS);
+
+    // A custom placement check (from Lua) can't be turned into a mask, so
+    // just try it at random spots.
+    if (check_place && map_place_valid != _map_safe_vault_place)
+        return _random_minivault_place(place, margin);
+
+    const vector<coord_def> origins =
+        _minivault_origins(place, check_place, margin);
+#ifdef DEBUG_MINIVAULT_PLACEMENT
+    mprf(MSGCH_DIAGNOSTICS, "%s: %u possible places",
+         place.map.name.c_str(), (unsigned int)origins.size());
+#endif
+    if (origins.empty())
+        return coord_def(-1, -1);
+    return origins[random2(origins.size())];
+}
+
 static bool _apply_vault_grid(map_def &def,
                               vault_placement &place,
                               bool check_place)
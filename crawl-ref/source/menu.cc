@@ -1700,13 +1700,19 @@ void Menu::webtiles_update_section_boundaries()
 
 int menu_colour(const string &text, const string &prefix, const string &tag)
 {
-    const string tmp_text = prefix + text;
+    static text_pattern_list patterns("menu_colour");
+    if (!patterns.current(Options.item_patterns_generation))
+    {
+        patterns.reset(Options.item_patterns_generation);
+        for (const colour_mapping &cm : Options.menu_colour_mappings)
+            patterns.add(cm.pattern);
+    }
 
-    for (const colour_mapping &cm : Options.menu_colour_mappings)
+    for (int i : patterns.matches(prefix + text))
     {
-        if ((cm.tag.empty() || cm.tag == "any" || cm.tag == tag
-               || cm.tag == "inventory" && tag == "pickup")
-            && cm.pattern.matches(tmp_text))
+        const colour_mapping &cm = Options.menu_colour_mappings[i];
+        if (cm.tag.empty() || cm.tag == "any" || cm.tag == tag
+            || cm.tag == "inventory" && tag == "pickup")
         {
             return cm.colour;
         }
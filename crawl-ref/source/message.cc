@@ -7,6 +7,7 @@
 
 #include "message.h"
 
+#include <chrono>
 #include <sstream>
 
 #include "areas.h"
@@ -647,6 +648,7 @@ public:
         if (_pre_more())
             return;
 
+        redraw_skipped_view();
         print_stats();
         show();
         int last_row = crawl_view.msgsz.y;
@@ -1151,9 +1153,129 @@ void dprf(diag_type param, const char *format, ...)
 
 static bool _updating_view = false;
 
+enum message_filter_kind
+{
+    MFK_MORE,
+    MFK_FLASH,
+    MFK_COLOUR,
+    MFK_NOTE,
+    NUM_MESSAGE_FILTER_KINDS
+};
+
+#ifdef DEBUG_MESSAGE_FILTERS
+static const char * const message_filter_kind_names[] =
+{
+    "force_more_message", "flash_screen_message", "message_colour",
+    "note_messages",
+};
+COMPILE_CHECK(ARRAYSZ(message_filter_kind_names) == NUM_MESSAGE_FILTER_KINDS);
+
+struct message_filter_cost
+{
+    int checks = 0;
+    int fallbacks = 0; // checks that had to try each pattern
+    chrono::microseconds time = chrono::microseconds::zero();
+};
+static message_filter_cost message_filter_costs[NUM_MESSAGE_FILTER_KINDS];
+
+class message_filter_timer
+{
+public:
+    message_filter_timer(message_filter_kind kind)
+        : cost(message_filter_costs[kind]),
+          start(chrono::steady_clock::now())
+    {
+        cost.checks++;
+    }
+    ~message_filter_timer()
+    {
+        cost.time += chrono::duration_cast<chrono::microseconds>(
+                         chrono::steady_clock::now() - start);
+    }
+    void fallback() { cost.fallbacks++; }
+private:
+    message_filter_cost &cost;
+    chrono::steady_clock::time_point start;
+};
+# define MESSAGE_FILTER_COST(kind) message_filter_timer _filter_timer(kind)
+# define MESSAGE_FILTER_FALLBACK() _filter_timer.fallback()
+
+void dump_message_filter_costs()
+{
+    FILE *f = fopen("message_filter_costs", "w");
+    ASSERT(f);
+
+    for (int i = 0; i < NUM_MESSAGE_FILTER_KINDS; ++i)
+    {
+        const message_filter_cost &cost = message_filter_costs[i];
+        const long long us = cost.time.count();
+        fprintf(f, "%10lld us %8d checks %8d fallbacks %6lld us/check %s\n",
+                us, cost.checks, cost.fallbacks,
+                us / max(cost.checks, 1), message_filter_kind_names[i]);
+    }
+    fclose(f);
+}
+#else
+# define MESSAGE_FILTER_COST(kind)
+# define MESSAGE_FILTER_FALLBACK()
+#endif
+
+/**
+ * All the patterns of one kind of message filter as a single matcher,
+ * rebuilt whenever the options behind it change.
+ */
+static const text_pattern_set &_message_filter_set(message_filter_kind kind)
+{
+    static text_pattern_set sets[NUM_MESSAGE_FILTER_KINDS];
+    static unsigned int generations[NUM_MESSAGE_FILTER_KINDS];
+    static bool built[NUM_MESSAGE_FILTER_KINDS];
+
+    text_pattern_set &set = sets[kind];
+    if (built[kind]
+        && generations[kind] == Options.message_filters_generation)
+    {
+        return set;
+    }
+
+    set.clear();
+    switch (kind)
+    {
+    case MFK_MORE:
+        for (const message_filter &mf : Options.force_more_message)
+            set.add(mf.pattern);
+        break;
+    case MFK_FLASH:
+        for (const message_filter &mf : Options.flash_screen_message)
+            set.add(mf.pattern);
+        break;
+    case MFK_COLOUR:
+        for (const message_colour_mapping &mcm
+             : Options.message_colour_mappings)
+        {
+            set.add(mcm.message.pattern);
+        }
+        break;
+    case MFK_NOTE:
+        for (const text_pattern &pat : Options.note_messages)
+            set.add(pat);
+        break;
+    default:
+        die("bad message filter kind %d", kind);
+    }
+    generations[kind] = Options.message_filters_generation;
+    built[kind] = true;
+    return set;
+}
+
 static bool _check_option(const string& line, msg_channel_type channel,
-                          const vector<message_filter>& option)
+                          const vector<message_filter>& option,
+                          message_filter_kind kind)
 {
+    MESSAGE_FILTER_COST(kind);
+    if (!_message_filter_set(kind).may_match(line))
+        return false;
+
+    MESSAGE_FILTER_FALLBACK();
     return any_of(begin(option),
                   end(option),
                   bind(mem_fn(&message_filter::is_filtered),
@@ -1162,12 +1284,14 @@ static bool _check_option(const string& line, msg_channel_type channel,
 
 static bool _check_more(const string& line, msg_channel_type channel)
 {
-    return _check_option(line, channel, Options.force_more_message);
+    return _check_option(line, channel, Options.force_more_message,
+                         MFK_MORE);
 }
 
 static bool _check_flash_screen(const string& line, msg_channel_type channel)
 {
-    return _check_option(line, channel, Options.flash_screen_message);
+    return _check_option(line, channel, Options.flash_screen_message,
+                         MFK_FLASH);
 }
 
 static bool _check_join(const string& line, msg_channel_type channel)
@@ -1448,20 +1572,23 @@ static void mpr_check_patterns(const string& message,
                                msg_channel_type channel,
                                int param)
 {
-    for (const text_pattern &pat : Options.note_messages)
+    if (channel != MSGCH_EQUIPMENT && channel != MSGCH_FLOOR_ITEMS
+        && channel != MSGCH_MULTITURN_ACTION
+        && channel != MSGCH_EXAMINE && channel != MSGCH_EXAMINE_FILTER
+        && channel != MSGCH_TUTORIAL && channel != MSGCH_DGL_MESSAGE)
     {
-        if (channel == MSGCH_EQUIPMENT || channel == MSGCH_FLOOR_ITEMS
-            || channel == MSGCH_MULTITURN_ACTION
-            || channel == MSGCH_EXAMINE || channel == MSGCH_EXAMINE_FILTER
-            || channel == MSGCH_TUTORIAL || channel == MSGCH_DGL_MESSAGE)
-        {
-            continue;
-        }
-
-        if (pat.matches(message))
+        MESSAGE_FILTER_COST(MFK_NOTE);
+        if (_message_filter_set(MFK_NOTE).may_match(message))
         {
-            take_note(Note(NOTE_MESSAGE, channel, param, message));
-            break;
+            MESSAGE_FILTER_FALLBACK();
+            for (const text_pattern &pat : Options.note_messages)
+            {
+                if (pat.matches(message))
+                {
+                    take_note(Note(NOTE_MESSAGE, channel, param, message));
+                    break;
+                }
+            }
         }
     }
 
@@ -1515,6 +1642,11 @@ static msg_colour_type prepare_message(const string& imsg,
     if (colour != MSGCOL_MUTED)
         mpr_check_patterns(imsg, channel, param);
 
+    MESSAGE_FILTER_COST(MFK_COLOUR);
+    if (!_message_filter_set(MFK_COLOUR).may_match(imsg))
+        return colour;
+
+    MESSAGE_FILTER_FALLBACK();
     for (const message_colour_mapping &mcm : Options.message_colour_mappings)
     {
         if (mcm.message.is_filtered(channel, imsg))
@@ -25,6 +25,10 @@ void flush_prev_message();
 
 void more(bool user_forced = false);
 
+#ifdef DEBUG_MESSAGE_FILTERS
+void dump_message_filter_costs();
+#endif
+
 void canned_msg(canned_message_type which_message);
 
 bool simple_monster_message(const monster* mons, const char *event,
@@ -134,8 +134,8 @@ bool ugly_thing_mutate(monster* ugly, bool force)
 // leaving durations unchanged, I guess. -cao
 static void _split_ench_durations(monster* initial_slime, monster* split_off)
 {
-    for (const auto &entry : initial_slime->enchantments)
-        split_off->add_ench(entry.second);
+    for (const mon_enchant &entry : initial_slime->enchantments)
+        split_off->add_ench(entry);
 }
 
 // What to do about any enchantments these two creatures may have?
@@ -149,35 +149,33 @@ void merge_ench_durations(monster* initial, monster* merge_to, bool usehd)
 
     mon_enchant_list &from_ench = initial->enchantments;
 
-    for (auto &entry : from_ench)
+    for (mon_enchant &entry : from_ench)
     {
         // Does the other creature have this enchantment as well?
-        const mon_enchant temp = merge_to->get_ench(entry.first);
+        const mon_enchant temp = merge_to->get_ench(entry.ench);
         // If not, use duration 0 for their part of the average.
         const bool no_initial = temp.ench == ENCH_NONE;
         const int duration = no_initial ? 0 : temp.duration;
 
-        entry.second.duration = (entry.second.duration * initial_count
-                                 + duration * merge_to_count)/total_count;
+        entry.duration = (entry.duration * initial_count
+                          + duration * merge_to_count)/total_count;
 
-        if (!entry.second.duration)
-            entry.second.duration = 1;
+        if (!entry.duration)
+            entry.duration = 1;
 
         if (no_initial)
-            merge_to->add_ench(entry.second);
+            merge_to->add_ench(entry);
         else
-            merge_to->update_ench(entry.second);
+            merge_to->update_ench(entry);
     }
 
-    for (auto &entry : merge_to->enchantments)
+    for (mon_enchant &entry : merge_to->enchantments)
     {
-        if (from_ench.find(entry.first) == from_ench.end()
-            && entry.second.duration > 1)
+        if (!from_ench.has(entry.ench) && entry.duration > 1)
         {
-            entry.second.duration = (merge_to_count * entry.second.duration)
-                                    / total_count;
+            entry.duration = (merge_to_count * entry.duration) / total_count;
 
-            merge_to->update_ench(entry.second);
+            merge_to->update_ench(entry);
         }
     }
 }
@@ -8,6 +8,7 @@
 #include "mon-cast.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <unordered_set>
 
@@ -3182,6 +3183,91 @@ static bool _long_target_range(const monster *mons)
               > LOS_RADIUS / 2;
 }
 
+#ifdef DEBUG_SPELL_COSTS
+struct spell_cost
+{
+    int evaluations;
+    chrono::microseconds time;
+};
+
+static map<spell_type, spell_cost> spell_costs;
+
+/// Charges the time until it goes out of scope to considering a spell.
+class spell_cost_timer
+{
+public:
+    spell_cost_timer(spell_type s)
+        : spell(s), start(chrono::steady_clock::now())
+    {
+    }
+    ~spell_cost_timer()
+    {
+        spell_cost &cost = spell_costs[spell];
+        cost.evaluations++;
+        cost.time += chrono::duration_cast<chrono::microseconds>(
+                         chrono::steady_clock::now() - start);
+    }
+private:
+    spell_type spell;
+    chrono::steady_clock::time_point start;
+};
+# define SPELL_COST(spell) spell_cost_timer _spell_cost_timer(spell)
+
+void dump_spell_costs()
+{
+    FILE *f = fopen("spell_costs", "w");
+    ASSERT(f);
+
+    vector<pair<spell_type, spell_cost>> costs(spell_costs.begin(),
+                                               spell_costs.end());
+    sort(costs.begin(), costs.end(),
+         [](const pair<spell_type, spell_cost> &a,
+            const pair<spell_type, spell_cost> &b)
+         {
+             return a.second.time > b.second.time;
+         });
+
+    for (const auto &entry : costs)
+    {
+        const long long us = entry.second.time.count();
+        fprintf(f, "%10lld us %8d evals %8lld us/eval %s\n", us,
+                entry.second.evaluations,
+                us / max(entry.second.evaluations, 1),
+                spell_title(entry.first));
+    }
+    fclose(f);
+}
+#else
+# define SPELL_COST(spell)
+#endif
+
+/**
+ * What one spell decision has already worked out.
+ *
+ * Nothing on the level changes while a monster picks its spell, so a
+ * tracer fired for a spell at a given target on one attempt gives the same
+ * answer on any later attempt (or Aura of Brilliance reroll) in the same
+ * decision, and need not be fired again.
+ */
+struct spell_eval_record
+{
+    struct traced
+    {
+        spell_type spell;
+        coord_def target;
+        bolt beam;
+    };
+    vector<traced> tracers;
+
+    const bolt *find_tracer(spell_type spell, const coord_def &target) const
+    {
+        for (const traced &t : tracers)
+            if (t.spell == spell && t.target == target)
+                return &t.beam;
+        return nullptr;
+    }
+};
+
 /**
  * Give a monster a chance to cast a spell.
  *
@@ -3227,9 +3313,13 @@ bool handle_mon_spell(monster* mons, bolt &beem)
     if (!hspell_pass.size())
         return false;
 
+    // Checked at most once: it scans the monster's whole LOS.
+    const bool enemies_around = mon_enemies_around(mons);
+    spell_eval_record eval;
+
     // Monsters caught in a net try to get away.
     // This is only urgent if enemies are around.
-    if (!finalAnswer && mon_enemies_around(mons)
+    if (!finalAnswer && enemies_around
         && mons->caught() && one_chance_in(15))
     {
         for (const mon_spell_slot &slot : hspell_pass)
@@ -3330,7 +3420,7 @@ bool handle_mon_spell(monster* mons, bolt &beem)
     {
         // If nothing found by now, safe friendlies and good
         // neutrals will rarely cast.
-        if (mons->wont_attack() && !mon_enemies_around(mons)
+        if (mons->wont_attack() && !enemies_around
             && !one_chance_in(10))
         {
             return false;
@@ -3338,6 +3428,7 @@ bool handle_mon_spell(monster* mons, bolt &beem)
 
         // Remove healing/invis/haste if we don't need them.
         erase_if(hspell_pass, [&](const mon_spell_slot &t) {
+            SPELL_COST(t.spell);
             return _ms_waste_of_time(mons, t)
                 // Should monster not have selected dig by now,
                 // it never will.
@@ -3484,9 +3575,19 @@ bool handle_mon_spell(monster* mons, bolt &beem)
             // beam-type spells requiring tracers
             if (get_spell_flags(spell_cast) & SPFLAG_NEEDS_TRACER)
             {
-                const bool explode =
-                    spell_is_direct_explosion(spell_cast);
-                fire_tracer(mons, beem, explode);
+                SPELL_COST(spell_cast);
+                if (const bolt *traced = eval.find_tracer(spell_cast,
+                                                          beem.target))
+                {
+                    beem = *traced;
+                }
+                else
+                {
+                    const bool explode =
+                        spell_is_direct_explosion(spell_cast);
+                    fire_tracer(mons, beem, explode);
+                    eval.tracers.push_back({ spell_cast, beem.target, beem });
+                }
                 // Good idea?
                 if (mons_should_fire(beem, ignore_good_idea))
                     spellOK = true;
@@ -47,4 +47,8 @@ void setup_breath_timeout(monster* mons);
 monster* cast_phantom_mirror(monster* mons, monster* targ,
                              int hp_perc = 35,
                              int summ_type = SPELL_PHANTOM_MIRROR);
+
+#ifdef DEBUG_SPELL_COSTS
+void dump_spell_costs();
+#endif
 #endif
@@ -2764,7 +2764,6 @@ item_def* mounted_kill(monster* daddy, monster_type mc, killer_type killer,
 
     // Need to copy ENCH_ABJ etc. or we could get real XP/meat from a summon.
     mon.enchantments = daddy->enchantments;
-    mon.ench_cache = daddy->ench_cache;
 
     mon.attitude = daddy->attitude;
     mon.damage_friendly = daddy->damage_friendly;
@@ -7,6 +7,7 @@
 
 #include "monster.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "act-iter.h"
@@ -56,7 +57,7 @@ bool monster::has_ench(enchant_type ench) const
     mon_enchant e = get_ench(ench);
     if (e.ench == ench)
     {
-        if (!ench_cache[ench])
+        if (!enchantments.has(ench))
         {
             die("monster %s has ench '%s' not in cache",
                 name(DESC_PLAIN).c_str(),
@@ -65,7 +66,7 @@ bool monster::has_ench(enchant_type ench) const
     }
     else if (e.ench == ENCH_NONE)
     {
-        if (ench_cache[ench])
+        if (enchantments.has(ench))
         {
             die("monster %s has no ench '%s' but cache says it does",
                 name(DESC_PLAIN).c_str(),
@@ -78,7 +79,7 @@ bool monster::has_ench(enchant_type ench) const
             string(e).c_str(),
             string(mon_enchant(ench)).c_str());
     }
-    return ench_cache[ench];
+    return enchantments.has(ench);
 }
 #endif
 
@@ -102,10 +103,11 @@ mon_enchant monster::get_ench(enchant_type ench1,
 
     for (int e = ench1; e <= ench2; ++e)
     {
-        auto i = enchantments.find(static_cast<enchant_type>(e));
-
-        if (i != enchantments.end())
-            return i->second;
+        if (const mon_enchant *me =
+                enchantments.find(static_cast<enchant_type>(e)))
+        {
+            return *me;
+        }
     }
 
     return mon_enchant();
@@ -115,7 +117,7 @@ void monster::update_ench(const mon_enchant &ench)
 {
     if (ench.ench != ENCH_NONE)
     {
-        if (mon_enchant *curr_ench = map_find(enchantments, ench.ench))
+        if (mon_enchant *curr_ench = enchantments.find(ench.ench))
             *curr_ench = ench;
     }
 }
@@ -155,14 +157,13 @@ bool monster::add_ench(const mon_enchant &ench)
     }
 
     bool new_enchantment = false;
-    mon_enchant *added = map_find(enchantments, ench.ench);
+    mon_enchant *added = enchantments.find(ench.ench);
     if (added)
         *added += ench;
     else
     {
         new_enchantment = true;
-        added = &(enchantments[ench.ench] = ench);
-        ench_cache.set(ench.ench, true);
+        added = &enchantments.set(ench);
     }
 
     // If the duration is not set, we must calculate it (depending on the
@@ -381,18 +382,16 @@ static bool _prepare_del_ench(monster* mon, const mon_enchant &me)
 
 bool monster::del_ench(enchant_type ench, bool quiet, bool effect)
 {
-    auto i = enchantments.find(ench);
-    if (i == enchantments.end())
+    const mon_enchant *i = enchantments.find(ench);
+    if (!i)
         return false;
 
-    const mon_enchant me = i->second;
-    const enchant_type et = i->first;
+    const mon_enchant me = *i;
 
     if (!_prepare_del_ench(this, me))
         return false;
 
-    enchantments.erase(et);
-    ench_cache.set(et, false);
+    enchantments.erase(me.ench);
     if (effect)
         remove_enchantment_effect(me, quiet);
     return true;
@@ -1000,7 +999,7 @@ string monster::describe_enchantments() const
     {
         if (i != enchantments.begin())
             oss << ", ";
-        oss << string(i->second);
+        oss << string(*i);
     }
     return oss.str();
 }
@@ -1857,7 +1856,8 @@ void monster::apply_enchantment(const mon_enchant &me)
             if (res_water_drowning() <= 0)
             {
                 lose_ench_duration(me, -speed_to_duration(speed));
-                int dam = div_rand_round((50 + stepdown((float)me.duration, 30.0))
+                const int hold_dur = get_ench(ENCH_WATER_HOLD).duration;
+                int dam = div_rand_round((50 + stepdown((float)hold_dur, 30.0))
                                           * speed_to_duration(speed),
                             BASELINE_DELAY * 10);
                 if (res_water_drowning() < 0)
@@ -2033,13 +2033,17 @@ void monster::apply_enchantments()
     // We process an enchantment only if it existed both at the start of this
     // function and when getting to it in order; any enchantment can add, modify
     // or remove others -- or even itself.
-    FixedBitVector<NUM_ENCHANTMENTS> ec = ench_cache;
+    enchant_type ec[NUM_ENCHANTMENTS];
+    int num_ench = 0;
+    for (const mon_enchant &me : enchantments)
+        ec[num_ench++] = me.ench;
 
     // The ordering in enchant_type makes sure that "super-enchantments"
-    // like berserk time out before their parts.
-    for (int i = 0; i < NUM_ENCHANTMENTS; ++i)
-        if (ec[i] && has_ench(static_cast<enchant_type>(i)))
-            apply_enchantment(enchantments.find(static_cast<enchant_type>(i))->second);
+    // like berserk time out before their parts. Each one is applied from a
+    // copy, since applying it may add or remove entries in the list.
+    for (int i = 0; i < num_ench; ++i)
+        if (const mon_enchant *me = enchantments.find(ec[i]))
+            apply_enchantment(mon_enchant(*me));
 }
 
 // Used to adjust time durations in calc_duration() for monster speed.
@@ -2148,6 +2152,47 @@ static const char *_mons_enchantment_name(enchant_type ench)
     return enchant_names[ench];
 }
 
+mon_enchant_list::iterator mon_enchant_list::lookup(enchant_type ench)
+{
+    return lower_bound(entries.begin(), entries.end(), mon_enchant(ench));
+}
+
+mon_enchant *mon_enchant_list::find(enchant_type ench)
+{
+    return present[ench] ? &*lookup(ench) : nullptr;
+}
+
+const mon_enchant *mon_enchant_list::find(enchant_type ench) const
+{
+    return const_cast<mon_enchant_list *>(this)->find(ench);
+}
+
+mon_enchant &mon_enchant_list::set(const mon_enchant &ench)
+{
+    auto i = lookup(ench.ench);
+    if (present[ench.ench])
+        return *i = ench;
+
+    present.set(ench.ench);
+    return *entries.insert(i, ench);
+}
+
+bool mon_enchant_list::erase(enchant_type ench)
+{
+    if (!present[ench])
+        return false;
+
+    entries.erase(lookup(ench));
+    present.set(ench, false);
+    return true;
+}
+
+void mon_enchant_list::clear()
+{
+    entries.clear();
+    present.reset();
+}
+
 enchant_type name_to_ench(const char *name)
 {
     for (unsigned int i = ENCH_NONE; i < ARRAYSZ(enchant_names); i++)
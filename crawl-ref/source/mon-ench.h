@@ -1,6 +1,10 @@
 #ifndef MON_ENCH_H
 #define MON_ENCH_H
 
+#include <vector>
+
+#include "bitary.h"
+
 #define INFINITE_DURATION  30000
 
 class actor;
@@ -51,6 +55,39 @@ private:
     int calc_duration(const monster* mons, const mon_enchant *added) const;
 };
 
+// The enchantments on a monster. Presence is kept in a bitset so that
+// has_ench() is a single bit test, and the active entries are packed in
+// enchant_type order so that iteration only visits what is actually set.
+class mon_enchant_list
+{
+public:
+    typedef vector<mon_enchant>::iterator       iterator;
+    typedef vector<mon_enchant>::const_iterator const_iterator;
+
+    bool has(enchant_type ench) const { return present[ench]; }
+    mon_enchant *find(enchant_type ench);
+    const mon_enchant *find(enchant_type ench) const;
+
+    // Adds ench, replacing any existing entry of the same type.
+    mon_enchant &set(const mon_enchant &ench);
+    bool erase(enchant_type ench);
+    void clear();
+
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+
+    iterator begin() { return entries.begin(); }
+    iterator end() { return entries.end(); }
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+
+private:
+    FixedBitVector<NUM_ENCHANTMENTS> present;
+    vector<mon_enchant> entries;
+
+    iterator lookup(enchant_type ench);
+};
+
 enchant_type name_to_ench(const char *name);
 
 #endif
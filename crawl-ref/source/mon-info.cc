@@ -597,9 +597,9 @@ monster_info::monster_info(const monster* m, int milev)
         }
     }
 
-    for (auto &entry : m->enchantments)
+    for (const mon_enchant &entry : m->enchantments)
     {
-        monster_info_flags flag = ench_to_mb(*m, entry.first);
+        monster_info_flags flag = ench_to_mb(*m, entry.ench);
         if (flag != NUM_MB_FLAGS)
             mb.set(flag);
     }
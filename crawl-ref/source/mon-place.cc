@@ -1174,15 +1174,30 @@ monster* place_monster(mgen_data mg, bool force_pos, bool dont_place)
     return mon;
 }
 
+// The lowest menv slot that may be free; every slot below it is in use.
+// monster::reset() reports freed slots through menv_slot_freed().
+static int _first_free_monster = 0;
+
+void menv_slot_freed(int mons)
+{
+    if (mons >= 0 && mons < _first_free_monster)
+        _first_free_monster = mons;
+}
+
 monster* get_free_monster()
 {
-    for (auto &mons : menv)
+    for (int i = _first_free_monster; i < (int) menv.size(); ++i)
+    {
+        monster &mons = menv[i];
         if (mons.type == MONS_NO_MONSTER)
         {
             mons.reset();
+            _first_free_monster = i;
             return &mons;
         }
+    }
 
+    _first_free_monster = menv.size();
     return nullptr;
 }
 
@@ -111,6 +111,7 @@ void set_vault_mon_list(const vector<mons_spec> &list);
 void setup_vault_mon_list();
 
 monster* get_free_monster();
+void menv_slot_freed(int mons);
 
 bool can_place_on_trap(monster_type mon_type, trap_type trap);
 void mons_add_blame(monster* mon, const string &blame_string);
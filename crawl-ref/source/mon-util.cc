@@ -2733,7 +2733,6 @@ void define_monster(monster* mons)
 
     // Reset monster enchantments.
     mons->enchantments.clear();
-    mons->ench_cache.reset();
     mons->ench_countdown = 0;
 
     switch (mcls)
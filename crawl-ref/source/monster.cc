@@ -112,9 +112,11 @@ monster &monster::operator = (const monster& mon)
 
 void monster::reset()
 {
+    if (this >= menv.buffer() && this < menv.buffer() + menv.size())
+        menv_slot_freed(mindex());
+
     mname.clear();
     enchantments.clear();
-    ench_cache.reset();
     ench_countdown = 0;
     inv.init(NON_ITEM);
     spells.clear();
@@ -187,7 +189,6 @@ void monster::init_with(const monster& mon)
     behaviour         = mon.behaviour;
     foe               = mon.foe;
     enchantments      = mon.enchantments;
-    ench_cache        = mon.ench_cache;
     flags             = mon.flags;
     experience        = mon.experience;
     number            = mon.number;
@@ -4660,7 +4661,6 @@ void monster::ghost_init(bool need_pos)
 
     inv.init(NON_ITEM);
     enchantments.clear();
-    ench_cache.reset();
     ench_countdown = 0;
 
     // Summoned player ghosts are already given a position; calling this
@@ -6209,7 +6209,6 @@ void monster::react_to_damage(const actor *oppressor, int damage,
             int old_hp                = hit_points;
             auto old_flags            = flags;
             mon_enchant_list old_ench = enchantments;
-            FixedBitVector<NUM_ENCHANTMENTS> old_ench_cache = ench_cache;
             int8_t old_ench_countdown = ench_countdown;
             string old_name = mname;
 
@@ -6221,7 +6220,6 @@ void monster::react_to_damage(const actor *oppressor, int damage,
             hit_points = min(old_hp, hit_points);
             flags          = old_flags;
             enchantments   = old_ench;
-            ench_cache     = old_ench_cache;
             ench_countdown = old_ench_countdown;
             // Keep the rider's name, if it had one (Mercenary card).
             if (!old_name.empty())
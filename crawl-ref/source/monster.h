@@ -21,8 +21,6 @@ const int KRAKEN_TENTACLE_RANGE = 3;
 
 #define DROPPER_MID_KEY "dropper_mid"
 
-typedef map<enchant_type, mon_enchant> mon_enchant_list;
-
 struct monsterentry;
 
 class monster : public actor
@@ -56,7 +54,6 @@ public:
     unsigned short foe;
     int8_t ench_countdown;
     mon_enchant_list enchantments;
-    FixedBitVector<NUM_ENCHANTMENTS> ench_cache;
     monster_flags_t flags;             // bitfield of boolean flags
 
     unsigned int experience;
@@ -170,7 +167,7 @@ public:
 #ifdef DEBUG_DIAGNOSTICS
     bool has_ench(enchant_type ench) const; // same but validated
 #else
-    bool has_ench(enchant_type ench) const { return ench_cache[ench]; }
+    bool has_ench(enchant_type ench) const { return enchantments.has(ench); }
 #endif
     bool has_ench(enchant_type ench, enchant_type ench2) const;
     mon_enchant get_ench(enchant_type ench,
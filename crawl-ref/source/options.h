@@ -281,6 +281,9 @@ public:
     vector<text_pattern> note_messages;  // Interesting messages
     vector<pair<text_pattern, string> > autoinscriptions;
     vector<text_pattern> note_items;     // Objects to note
+    // Bumped whenever force_autopickup, autoinscriptions, note_items or
+    // menu_colour_mappings change.
+    unsigned int item_patterns_generation;
     // Skill levels to note
     FixedBitVector<MAX_SKILL_LEVEL + 1> note_skill_levels;
     vector<pair<text_pattern, string>> auto_spell_letters;
@@ -291,6 +294,8 @@ public:
     int         travel_delay;   // How long to pause between travel moves
     int         explore_delay;  // How long to pause between explore moves
     int         rest_delay;     // How long to pause between rest moves
+    int         runrest_max_fps; // Most view redraws per second while moving
+                                 // automatically; 0 for no limit
 
     bool        show_travel_trail;
 
@@ -302,6 +307,9 @@ public:
 
     vector<message_filter> force_more_message;
     vector<message_filter> flash_screen_message;
+    // Bumped whenever force_more_message, flash_screen_message,
+    // message_colour_mappings or note_messages change.
+    unsigned int message_filters_generation;
     vector<text_pattern> confirm_action;
 
     int         tc_reachable;   // Colour for squares that are reachable
@@ -402,6 +410,8 @@ public:
 
     bool        use_fake_cursor;    // Draw a fake cursor instead of relying
                                     // on the term's own cursor.
+    bool        pregen_levels;      // Build likely next levels in a
+                                    // background process.
     bool        use_fake_player_cursor;
 
     bool        show_player_species;
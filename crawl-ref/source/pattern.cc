@@ -48,6 +48,46 @@ static bool _pattern_match(void *compiled_pattern, const char *text, int length)
     return pcre_rc >= 0;
 }
 
+static void *_study_pattern(void *compiled_pattern)
+{
+    const char *error;
+#ifdef PCRE_STUDY_JIT_COMPILE
+    return pcre_study(static_cast<pcre *>(compiled_pattern),
+                      PCRE_STUDY_JIT_COMPILE, &error);
+#else
+    return pcre_study(static_cast<pcre *>(compiled_pattern), 0, &error);
+#endif
+}
+
+static void _free_study(void *extra)
+{
+    if (extra)
+    {
+#ifdef PCRE_STUDY_JIT_COMPILE
+        pcre_free_study(static_cast<pcre_extra *>(extra));
+#else
+        pcre_free(extra);
+#endif
+    }
+}
+
+static bool _studied_pattern_match(void *compiled_pattern, void *extra,
+                                   const char *text, int length)
+{
+    int ovector[42];
+    int pcre_rc = pcre_exec(static_cast<pcre *>(compiled_pattern),
+                            static_cast<pcre_extra *>(extra),
+                            text, length, 0, 0,
+                            ovector, sizeof(ovector) / sizeof(*ovector));
+    return pcre_rc >= 0;
+}
+
+// Wrap one pattern so it can be one branch of an alternation.
+static string _pattern_branch(const string &pattern, bool icase)
+{
+    return (icase ? "(?i:" : "(?:") + pattern + ")";
+}
+
 static pattern_match _pattern_match_location(void *compiled_pattern,
                                              const char *text, int length)
 {
@@ -102,6 +142,28 @@ static bool _pattern_match(void *compiled_pattern, const char *text, int length)
     return !regexec(re, text, 0, nullptr, 0);
 }
 
+static void *_study_pattern(void *)
+{
+    return nullptr;
+}
+
+static void _free_study(void *)
+{
+}
+
+static bool _studied_pattern_match(void *compiled_pattern, void *,
+                                   const char *text, int length)
+{
+    return _pattern_match(compiled_pattern, text, length);
+}
+
+// POSIX has no inline flags, so every branch shares the set's case
+// sensitivity.
+static string _pattern_branch(const string &pattern, bool)
+{
+    return "(" + pattern + ")";
+}
+
 static pattern_match _pattern_match_location(void *compiled_pattern,
                                              const char *text, int length)
 {
@@ -191,6 +253,214 @@ pattern_match text_pattern::match_location(const char *s, int length) const
         return pattern_match::failed(string(s));
 }
 
+/**
+ * Can this pattern be one branch of an alternation and still match exactly
+ * what it matches alone? Anything that refers to groups by number or
+ * changes how the rest of the pattern is read is kept apart.
+ */
+static bool _mergeable_pattern(const string &pattern)
+{
+    static const char * const unsafe[] =
+    {
+        "\\Q", "\\g", "\\k", "(*", "(?|", "(?P", "(?R", "(?&", "(?#",
+    };
+    for (const char *token : unsafe)
+        if (pattern.find(token) != string::npos)
+            return false;
+
+    for (string::size_type pos = pattern.find('\\'); pos != string::npos;
+         pos = pattern.find('\\', pos + 2))
+    {
+        // Back references.
+        if (pos + 1 < pattern.size() && isadigit(pattern[pos + 1])
+            && pattern[pos + 1] != '0')
+        {
+            return false;
+        }
+    }
+
+    for (string::size_type pos = pattern.find("(?"); pos != string::npos;
+         pos = pattern.find("(?", pos + 2))
+    {
+        // Subroutine calls such as (?1) and (?-1).
+        const string rest = pattern.substr(pos + 2, 2);
+        if (!rest.empty() && (rest[0] == '+' || isadigit(rest[0])
+                              || rest[0] == '-' && rest.size() > 1
+                                 && isadigit(rest[1])))
+        {
+            return false;
+        }
+
+        // Inline options including x, which would let a comment swallow
+        // the closing parenthesis.
+        const string::size_type end = pattern.find_first_of(":)", pos + 2);
+        const string opts = pattern.substr(pos + 2, end - pos - 2);
+        if (opts.find('x') != string::npos
+            && opts.find_first_not_of("imsxJU-") == string::npos)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+text_pattern_set::text_pattern_set()
+    : count(0), mergeable(true), ignore_case(false), compiled(false),
+      compiled_pattern(nullptr), extra(nullptr)
+{
+}
+
+text_pattern_set::~text_pattern_set()
+{
+    clear();
+}
+
+void text_pattern_set::clear()
+{
+    _free_study(extra);
+    _free_compiled_pattern(compiled_pattern);
+    extra = nullptr;
+    compiled_pattern = nullptr;
+    compiled = false;
+    combined.clear();
+    count = 0;
+    mergeable = true;
+    ignore_case = false;
+}
+
+void text_pattern_set::add(const text_pattern &pat)
+{
+    ASSERT(!compiled);
+
+    const string &pattern = pat.tostring();
+    if (pattern.empty() || !_mergeable_pattern(pattern)
+#ifndef REGEX_PCRE
+        || count && pat.case_insensitive() != ignore_case
+#endif
+        )
+    {
+        mergeable = false;
+    }
+
+    if (!count)
+        ignore_case = pat.case_insensitive();
+    else
+        combined += "|";
+    combined += _pattern_branch(pattern, pat.case_insensitive());
+    count++;
+}
+
+void text_pattern_set::compile() const
+{
+    compiled = true;
+    if (!count || !mergeable)
+        return;
+
+#ifdef REGEX_PCRE
+    // Case is set per branch.
+    compiled_pattern = _compile_pattern(combined.c_str(), false);
+#else
+    compiled_pattern = _compile_pattern(combined.c_str(), ignore_case);
+#endif
+    if (compiled_pattern)
+        extra = _study_pattern(compiled_pattern);
+}
+
+bool text_pattern_set::may_match(const string &s) const
+{
+    if (!count)
+        return false;
+    if (!compiled)
+        compile();
+    // If the patterns couldn't be merged, each must be tried.
+    if (!compiled_pattern)
+        return true;
+    return _studied_pattern_match(compiled_pattern, extra, s.c_str(),
+                                  s.length());
+}
+
+// More than this many remembered strings and a list starts over.
+#define MAX_PATTERN_LIST_RESULTS 2048
+
+#ifdef DEBUG_PATTERN_CACHE
+static vector<const text_pattern_list *> &_pattern_lists()
+{
+    static vector<const text_pattern_list *> lists;
+    return lists;
+}
+#endif
+
+text_pattern_list::text_pattern_list(const char *_name)
+    : name(_name), generation(0), built(false), hits(0), misses(0)
+{
+#ifdef DEBUG_PATTERN_CACHE
+    _pattern_lists().push_back(this);
+#endif
+}
+
+text_pattern_list::~text_pattern_list()
+{
+#ifdef DEBUG_PATTERN_CACHE
+    vector<const text_pattern_list *> &lists = _pattern_lists();
+    lists.erase(remove(lists.begin(), lists.end(), this), lists.end());
+#endif
+}
+
+void text_pattern_list::reset(unsigned int gen)
+{
+    patterns.clear();
+    set.clear();
+    results.clear();
+    generation = gen;
+    built = true;
+}
+
+void text_pattern_list::add(const text_pattern &pat)
+{
+    patterns.push_back(&pat);
+    set.add(pat);
+}
+
+const vector<int> &text_pattern_list::matches(const string &s) const
+{
+    auto it = results.find(s);
+    if (it != results.end())
+    {
+        hits++;
+        return it->second;
+    }
+
+    misses++;
+    if (results.size() >= MAX_PATTERN_LIST_RESULTS)
+        results.clear();
+
+    vector<int> &found = results[s];
+    if (set.may_match(s))
+    {
+        for (size_t i = 0; i < patterns.size(); ++i)
+            if (patterns[i]->matches(s))
+                found.push_back(i);
+    }
+    return found;
+}
+
+#ifdef DEBUG_PATTERN_CACHE
+void text_pattern_list::dump_stats()
+{
+    FILE *f = fopen("pattern_cache", "w");
+    ASSERT(f);
+
+    for (const text_pattern_list *list : _pattern_lists())
+    {
+        fprintf(f, "%8d hits %8d misses %4u patterns %s\n", list->hits,
+                list->misses, (unsigned int) list->patterns.size(),
+                list->name);
+    }
+    fclose(f);
+}
+#endif
+
 const plaintext_pattern &plaintext_pattern::operator= (const string &spattern)
 {
     if (pattern == spattern)
@@ -1,6 +1,8 @@
 #ifndef PATTERN_H
 #define PATTERN_H
 
+#include <unordered_map>
+
 class pattern_match
 {
 public:
@@ -117,6 +119,8 @@ public:
         return pattern;
     }
 
+    bool case_insensitive() const { return ignore_case; }
+
 private:
     string pattern;
     mutable void *compiled_pattern;
@@ -124,6 +128,81 @@ private:
     bool ignore_case;
 };
 
+/**
+ * A group of text_patterns compiled into a single alternation, so that a
+ * string matching none of them, the usual case, costs one search instead
+ * of one per pattern. Patterns that can't be merged safely (back
+ * references, verbs and the like) make may_match() always say yes, and
+ * the caller falls back to testing each pattern.
+ */
+class text_pattern_set
+{
+public:
+    text_pattern_set();
+    ~text_pattern_set();
+
+    void clear();
+    void add(const text_pattern &pat);
+
+    /// False only if none of the added patterns can match s.
+    bool may_match(const string &s) const;
+
+private:
+    text_pattern_set(const text_pattern_set &) = delete;
+    text_pattern_set &operator= (const text_pattern_set &) = delete;
+
+    void compile() const;
+
+    string combined;
+    int count;
+    bool mergeable;
+    bool ignore_case;
+    mutable bool compiled;
+    mutable void *compiled_pattern;
+    mutable void *extra;
+};
+
+/**
+ * A list of text_patterns that remembers which of them matched each string
+ * it has been asked about. Item names and menu lines are tested against
+ * the same option lists over and over, and a name only changes when the
+ * item or what the player knows about it does.
+ *
+ * The list holds pointers to the patterns, so it must be reset whenever
+ * the vector they live in changes.
+ */
+class text_pattern_list
+{
+public:
+    text_pattern_list(const char *name);
+    ~text_pattern_list();
+
+    /// Drop all patterns and remembered results; gen identifies the
+    /// options the new patterns come from.
+    void reset(unsigned int gen);
+    bool current(unsigned int gen) const { return built && generation == gen; }
+    void add(const text_pattern &pat);
+
+    /// The indices, in order, of the patterns that match s.
+    const vector<int> &matches(const string &s) const;
+
+#ifdef DEBUG_PATTERN_CACHE
+    static void dump_stats();
+#endif
+
+private:
+    text_pattern_list(const text_pattern_list &) = delete;
+    text_pattern_list &operator= (const text_pattern_list &) = delete;
+
+    const char *name;
+    unsigned int generation;
+    bool built;
+    vector<const text_pattern *> patterns;
+    text_pattern_set set;
+    mutable unordered_map<string, vector<int>> results;
+    mutable int hits, misses;
+};
+
 class plaintext_pattern : public base_pattern
 {
 public:
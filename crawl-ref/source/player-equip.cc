@@ -57,6 +57,7 @@ void equip_item(equipment_type slot, int item_slot, bool msg)
     ASSERT(!you.melded[slot]);
 
     you.equip[slot] = item_slot;
+    you.artefacts_changed();
 
     equip_effect(slot, item_slot, false, msg);
     ash_check_bondage();
@@ -76,6 +77,7 @@ bool unequip_item(equipment_type slot, bool msg)
     else
     {
         you.equip[slot] = -1;
+        you.artefacts_changed();
 
         if (!you.melded[slot])
             unequip_effect(slot, item_slot, false, msg);
@@ -3753,43 +3753,106 @@ int slaying_bonus(bool ranged)
     return ret;
 }
 
+// The worn artefact in the given slot, if any.
+static const item_def *_worn_artefact(const player &p, int slot)
+{
+    if (p.melded[slot] || p.equip[slot] == -1)
+        return nullptr;
+
+    const item_def &item = p.inv[p.equip[slot]];
+
+    // Only weapons give their effects when in our hands.
+    if (slot == EQ_WEAPON && item.base_type != OBJ_WEAPONS)
+        return nullptr;
+
+    return is_artefact(item) ? &item : nullptr;
+}
+
 // Checks each equip slot for a randart, and adds up all of those with
 // a given property. Slow if any randarts are worn, so avoid where
 // possible. If `matches' is non-nullptr, items with nonzero property are
 // pushed onto *matches.
-int player::scan_artefacts(artefact_prop_type which_property,
-                           bool calc_unid,
-                           vector<item_def> *matches) const
+static int _scan_artefacts(const player &p, artefact_prop_type which_property,
+                           bool calc_unid, vector<item_def> *matches)
 {
     int retval = 0;
 
     for (int i = EQ_WEAPON; i < NUM_EQUIP; ++i)
     {
-        if (melded[i] || equip[i] == -1)
-            continue;
-
-        const int eq = equip[i];
-
-        // Only weapons give their effects when in our hands.
-        if (i == EQ_WEAPON && inv[ eq ].base_type != OBJ_WEAPONS)
-            continue;
-
-        if (!is_artefact(inv[ eq ]))
+        const item_def *item = _worn_artefact(p, i);
+        if (!item)
             continue;
 
         bool known;
-        int val = artefact_property(inv[eq], which_property, known);
+        int val = artefact_property(*item, which_property, known);
         if (calc_unid || known)
         {
             retval += val;
             if (matches && val)
-                matches->push_back(inv[eq]);
+                matches->push_back(*item);
         }
     }
 
     return retval;
 }
 
+/**
+ * The total of an artefact property over the player's worn gear.
+ *
+ * Unpacking an artefact's properties is slow, and combat, the status
+ * display and monster AI all ask after them many times a turn, so the
+ * totals of every property are taken in one pass and kept until the equip
+ * or melded state changes. Anything that alters a worn artefact in place
+ * must call artefacts_changed(). Identification state isn't tracked, so
+ * only calc_unid lookups are served from the totals.
+ *
+ * @param which_property  The property to total.
+ * @param calc_unid       Whether to count properties the player doesn't know.
+ * @param matches         If non-null, worn items with a nonzero value for
+ *                        the property are pushed onto it.
+ * @return                The sum of the property over all worn artefacts.
+ */
+int player::scan_artefacts(artefact_prop_type which_property,
+                           bool calc_unid,
+                           vector<item_def> *matches) const
+{
+    if (!calc_unid || matches)
+        return _scan_artefacts(*this, which_property, calc_unid, matches);
+
+    if (!artp_totals_valid || artp_totals_melded != melded
+        || !equal(equip.begin(), equip.end(), artp_totals_equip.begin()))
+    {
+        artp_totals.init(0);
+        for (int i = EQ_WEAPON; i < NUM_EQUIP; ++i)
+        {
+            const item_def *item = _worn_artefact(*this, i);
+            if (!item)
+                continue;
+
+            artefact_properties_t proprt;
+            proprt.init(0);
+            artefact_properties(*item, proprt);
+            for (int prop = 0; prop < ARTP_NUM_PROPERTIES; ++prop)
+                artp_totals[prop] += proprt[prop];
+        }
+        artp_totals_equip = equip;
+        artp_totals_melded = melded;
+        artp_totals_valid = true;
+    }
+
+#ifdef DEBUG
+    ASSERT(artp_totals[which_property]
+           == _scan_artefacts(*this, which_property, true, nullptr));
+#endif
+    return artp_totals[which_property];
+}
+
+/// Forget the worn-artefact totals, after a worn item changed in place.
+void player::artefacts_changed()
+{
+    artp_totals_valid = false;
+}
+
 void calc_hp()
 {
     int oldhp = you.hp, oldmax = you.hp_max;
@@ -5209,6 +5272,7 @@ player::player()
     equip.init(-1);
     melded.reset();
     unrand_reacts.reset();
+    artp_totals_valid = false;
 
     symbol          = MONS_PLAYER;
     form            = TRAN_NONE;
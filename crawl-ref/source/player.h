@@ -423,6 +423,13 @@ public:
 protected:
     FixedVector<PlaceInfo, NUM_BRANCHES> branch_info;
 
+    // Each artefact property summed over the worn gear, and the equip and
+    // melded state those sums were taken from; see scan_artefacts().
+    mutable FixedVector<int, ARTP_NUM_PROPERTIES> artp_totals;
+    mutable FixedVector<int8_t, NUM_EQUIP> artp_totals_equip;
+    mutable FixedBitVector<NUM_EQUIP> artp_totals_melded;
+    mutable bool artp_totals_valid;
+
 public:
     player();
     virtual ~player();
@@ -587,6 +594,7 @@ public:
     int scan_artefacts(artefact_prop_type which_property,
                        bool calc_unid = true,
                        vector<item_def> *matches = nullptr) const override;
+    void artefacts_changed();
 
     item_def *weapon(int which_attack = -1) const override;
     item_def *shield() const override;
@@ -13,6 +13,7 @@
 #include "syscalls.h"
 
 static FixedVector<PcgRNG, NUM_RNGS> rngs;
+static rng_type _generator = RNG_GAMEPLAY;
 
 uint32_t get_uint32(int generator)
 {
@@ -24,6 +25,26 @@ uint64_t get_uint64(int generator)
     return rngs[generator].get_uint64();
 }
 
+uint32_t get_uint32()
+{
+    return get_uint32(_generator);
+}
+
+uint64_t get_uint64()
+{
+    return get_uint64(_generator);
+}
+
+rng_generator::rng_generator(rng_type g) : previous(_generator)
+{
+    _generator = g;
+}
+
+rng_generator::~rng_generator()
+{
+    _generator = previous;
+}
+
 static void _seed_rng(uint64_t seed_array[], int seed_len)
 {
     PcgRNG seeded(seed_array, seed_len);
@@ -35,6 +56,16 @@ static void _seed_rng(uint64_t seed_array[], int seed_len)
     }
 }
 
+/**
+ * Reseed a single generator, leaving the others untouched. Used to give
+ * a stream (such as level generation) a state that depends only on the
+ * key, not on anything drawn before.
+ */
+void seed_rng(rng_type generator, uint64_t seed_array[], int seed_len)
+{
+    rngs[generator] = PcgRNG(seed_array, seed_len);
+}
+
 void seed_rng(uint32_t seed)
 {
     uint64_t sarg[1] = { seed };
@@ -109,7 +140,7 @@ static int _random2(int max, int rng)
 // [0, max)
 int random2(int max)
 {
-    return _random2(max, RNG_GAMEPLAY);
+    return _random2(max, _generator);
 }
 
 // [0, max), separate RNG state
@@ -11,9 +11,12 @@
 void seed_rng();
 void seed_rng(uint32_t seed);
 void seed_rng(uint64_t[], int);
+void seed_rng(rng_type generator, uint64_t[], int);
 
-uint32_t get_uint32(int generator = RNG_GAMEPLAY);
-uint64_t get_uint64(int generator = RNG_GAMEPLAY);
+uint32_t get_uint32(int generator);
+uint64_t get_uint64(int generator);
+uint32_t get_uint32();
+uint64_t get_uint64();
 bool coinflip();
 int div_rand_round(int num, int den);
 int div_round_up(int num, int den);
@@ -38,6 +41,19 @@ bool decimal_chance(double percent);
 
 int ui_random(int max);
 
+/**
+ * While in scope, random2() and the other functions that don't name a
+ * generator draw from g instead of RNG_GAMEPLAY.
+ */
+class rng_generator
+{
+public:
+    rng_generator(rng_type g);
+    ~rng_generator();
+private:
+    rng_type previous;
+};
+
 /** Chooses one of the objects passed in at random (by value).
  *  @return One of the arguments.
  *
@@ -316,17 +316,27 @@ void rot_floor_items(int elapsedTime)
     const int rot_time = elapsedTime / ROT_TIME_FACTOR;
 
     for (int mitm_index = 0; mitm_index < MAX_ITEMS; ++mitm_index)
-    {
-        item_def &it = mitm[mitm_index];
+        rot_floor_item(mitm_index, rot_time);
+}
 
-        if (is_shop_item(it) || !_item_needs_rot_check(it))
-            continue;
+/**
+ * Decay a single floor item, if it's the kind of thing that decays.
+ *
+ * @param mitm_index    The item's index in mitm.
+ * @param rot_time      The amount of time to rot for, in corpse units
+ *                      (aut / ROT_TIME_FACTOR).
+ */
+void rot_floor_item(int mitm_index, int rot_time)
+{
+    item_def &it = mitm[mitm_index];
 
-        if (it.base_type == OBJ_CORPSES)
-            _rot_corpse(it, mitm_index, rot_time);
-        else
-            _rot_stack(it, mitm_index, false);
-    }
+    if (is_shop_item(it) || !_item_needs_rot_check(it))
+        return;
+
+    if (it.base_type == OBJ_CORPSES)
+        _rot_corpse(it, mitm_index, rot_time);
+    else
+        _rot_stack(it, mitm_index, false);
 }
 
 /**
@@ -2274,6 +2274,29 @@ void ShoppingList::move_things(const coord_def &_src, const coord_def &_dst)
             thing[SHOPPING_THING_POS_KEY] = dst;
 }
 
+// Moves everything listed on the current level by delta.
+void ShoppingList::shift_things(const coord_def &delta)
+{
+    if (crawl_state.map_stat_gen
+        || crawl_state.obj_stat_gen
+        || crawl_state.test)
+    {
+        return; // Shopping list is unitialized and uneeded.
+    }
+
+    const level_id here = level_id::current();
+
+    for (CrawlHashTable &thing : *list)
+    {
+        level_pos pos = thing_pos(thing);
+        if (pos.is_on(here))
+        {
+            pos.pos += delta;
+            thing[SHOPPING_THING_POS_KEY] = pos;
+        }
+    }
+}
+
 void ShoppingList::forget_pos(const level_pos &pos)
 {
     if (!crawl_state.need_save)
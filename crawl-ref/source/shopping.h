@@ -68,6 +68,7 @@ public:
     void gold_changed(int old_amount, int new_amount);
 
     void move_things(const coord_def &src, const coord_def &dst);
+    void shift_things(const coord_def &delta);
     void forget_pos(const level_pos &pos);
 
     void display();
@@ -154,6 +154,12 @@ static void _initialize()
     }
 #endif
 
+#ifdef DEBUG_STATISTICS
+    // Timings are only comparable between runs that build the same levels.
+    if (SysEnv.map_gen_bench && !Options.seed)
+        Options.seed = 0xc0ffee;
+#endif
+
     if (Options.seed)
         seed_rng(Options.seed);
 
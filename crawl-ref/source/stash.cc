@@ -23,6 +23,7 @@
 #include "env.h"
 #include "feature.h"
 #include "godpassive.h"
+#include "hash.h"
 #include "hints.h"
 #include "invent.h"
 #include "itemprop.h"
@@ -65,9 +66,10 @@ string userdef_annotate_item(const char *s, const item_def *item,
 #endif
 }
 
-string stash_annotate_item(const char *s, const item_def *item, bool exclusive)
+// The parts of a stash annotation that don't come from Lua.
+static string _stash_item_notes(const item_def *item)
 {
-    string text = userdef_annotate_item(s, item, exclusive);
+    string text;
 
     if (item->has_spells())
     {
@@ -96,6 +98,78 @@ string stash_annotate_item(const char *s, const item_def *item, bool exclusive)
     return text;
 }
 
+string stash_annotate_item(const char *s, const item_def *item, bool exclusive)
+{
+    return userdef_annotate_item(s, item, exclusive) + _stash_item_notes(item);
+}
+
+#ifdef CLUA_BINDINGS
+// A registry reference keeping the search annotation hook as stash.lua
+// defines it, and the Lua state that reference belongs to.
+static int builtin_search_hook = LUA_NOREF;
+static lua_State *builtin_search_hook_state = nullptr;
+#endif
+
+/**
+ * Remember the stash hooks the Lua builtins just defined, so that searches
+ * can tell whether they have been replaced since.
+ */
+void remember_builtin_stash_hooks()
+{
+#ifdef CLUA_BINDINGS
+    lua_State *ls = clua.state();
+    if (builtin_search_hook_state == ls)
+        luaL_unref(ls, LUA_REGISTRYINDEX, builtin_search_hook);
+    lua_getglobal(ls, STASH_LUA_SEARCH_ANNOTATE);
+    builtin_search_hook = luaL_ref(ls, LUA_REGISTRYINDEX);
+    builtin_search_hook_state = ls;
+#endif
+}
+
+// Is there no search annotation hook at all?
+static bool _search_hook_is_nil()
+{
+#ifdef CLUA_BINDINGS
+    lua_State *ls = clua.state();
+    lua_stack_cleaner cleaner(ls);
+    lua_getglobal(ls, STASH_LUA_SEARCH_ANNOTATE);
+    return lua_isnil(ls, -1);
+#else
+    return true;
+#endif
+}
+
+/**
+ * Can what the search annotation hook says about a stash item be kept
+ * along with the item's name?
+ *
+ * That holds when there is no hook, or when it is still the one from
+ * stash.lua. That one only looks at the item itself (its flags, type,
+ * ego, artefact and god gift status), its identification, and the
+ * player's species, form and mutations (for is_throwable and
+ * is_preferred_food). All of those are covered by the stash version and
+ * the search context. Stash items are never in the inventory or in a
+ * shop. A hook replaced from an rc file or the Lua console is asked again
+ * on every search.
+ */
+static bool _search_hook_cacheable()
+{
+#ifdef CLUA_BINDINGS
+    if (_search_hook_is_nil())
+        return true;
+
+    lua_State *ls = clua.state();
+    if (ls != builtin_search_hook_state)
+        return false;
+    lua_stack_cleaner cleaner(ls);
+    lua_getglobal(ls, STASH_LUA_SEARCH_ANNOTATE);
+    lua_rawgeti(ls, LUA_REGISTRYINDEX, builtin_search_hook);
+    return lua_rawequal(ls, -1, -2);
+#else
+    return true;
+#endif
+}
+
 void maybe_update_stashes()
 {
     if (!crawl_state.game_is_arena())
@@ -165,6 +239,8 @@ static void _fully_identify_item(item_def *item)
 // Stash
 // ----------------------------------------------------------------------
 
+static unsigned int _last_stash_version = 0;
+
 Stash::Stash(coord_def pos_) : items()
 {
     // First, fix what square we're interested in
@@ -175,6 +251,11 @@ Stash::Stash(coord_def pos_) : items()
     update();
 }
 
+void Stash::_changed()
+{
+    version = ++_last_stash_version;
+}
+
 bool Stash::are_items_same(const item_def &a, const item_def &b, bool exact)
 {
     const bool same = a.is_type(b.base_type, b.sub_type)
@@ -245,11 +326,14 @@ bool Stash::unmark_trapping_nets()
     for (auto &item : items)
         if (item_is_stationary_net(item))
             item.net_placed = false, changed = true;
+    if (changed)
+        _changed();
     return changed;
 }
 
 void Stash::update()
 {
+    _changed();
     feat = grd(pos);
     trap = NUM_TRAPS;
 
@@ -438,6 +522,123 @@ string Stash::feature_description() const
     return feat_desc;
 }
 
+// The strings Stash::matches_search() tests for one item.
+struct stash_item_text
+{
+    string name;    // stash_item_name()
+    string hook;    // the search annotation hook's, if cacheable
+    string notes;   // the rest of stash_annotate_item()
+    string dump;    // chardump_desc() of a dumpable artefact
+    // Sorted trigrams of the lowercased texts, if the hook's is included.
+    vector<uint32_t> trigrams;
+};
+
+// What a stash's items looked like to search the last time, so that later
+// searches needn't rebuild their names while neither the stash nor the
+// player's knowledge has changed.
+struct stash_search_entry
+{
+    unsigned int version;  // Stash::version when built
+    uint32_t context;      // search_context when built
+    unsigned int searched; // search_serial when last used
+    bool hook_cached;      // whether the items' hook texts are kept
+    vector<stash_item_text> items;
+};
+
+static map<pair<string, coord_def>, stash_search_entry> stash_search_cache;
+
+// A hash of what item names and annotations depend on besides the items
+// themselves; set by StashTracker::get_matching_stashes().
+static uint32_t search_context = 0;
+static unsigned int search_serial = 0;
+// Whether _search_hook_cacheable(), as of the current search.
+static bool search_hook_cached = false;
+
+static uint32_t _search_context()
+{
+    const uint32_t parts[] =
+    {
+        Options.item_patterns_generation,
+        (uint32_t) Options.autopickup_on,
+        hash32(&Options.autopickups, sizeof(Options.autopickups)),
+        hash32(&you.force_autopickup, sizeof(you.force_autopickup)),
+        hash32(&you.type_ids, sizeof(you.type_ids)),
+        hash32(&you.mutation, sizeof(you.mutation)),
+        hash32(&you.spells, sizeof(you.spells)),
+        (uint32_t) you.species,
+        (uint32_t) you.form,
+        (uint32_t) you.religion,
+        (uint32_t) you.experience_level,
+    };
+    return hash32(parts, sizeof(parts));
+}
+
+static void _add_trigrams(vector<uint32_t> &trigrams, const string &text)
+{
+    const string lower = lowercase_string(text);
+    for (size_t i = 0; i + 2 < lower.size(); ++i)
+    {
+        trigrams.push_back((uint8_t) lower[i] << 16
+                           | (uint8_t) lower[i + 1] << 8
+                           | (uint8_t) lower[i + 2]);
+    }
+}
+
+// Are all of wanted among the (sorted) trigrams? If not, no text they
+// came from can contain what wanted came from, whatever the case
+// sensitivity.
+static bool _has_trigrams(const vector<uint32_t> &trigrams,
+                          const vector<uint32_t> &wanted)
+{
+    for (uint32_t trigram : wanted)
+        if (!binary_search(trigrams.begin(), trigrams.end(), trigram))
+            return false;
+    return true;
+}
+
+const stash_search_entry &Stash::_search_entry(const string &prefix) const
+{
+    stash_search_entry &entry = stash_search_cache[make_pair(prefix, pos)];
+    entry.searched = search_serial;
+    if (entry.version == version && entry.context == search_context
+        && entry.hook_cached == search_hook_cached
+        && entry.items.size() == items.size())
+    {
+        return entry;
+    }
+
+    entry.version = version;
+    entry.context = search_context;
+    entry.hook_cached = search_hook_cached;
+    entry.items.clear();
+    for (const item_def &item : items)
+    {
+        stash_item_text text;
+        text.name = stash_item_name(item);
+        text.notes = _stash_item_notes(&item);
+        if (is_dumpable_artefact(item))
+            text.dump = chardump_desc(item);
+
+        if (search_hook_cached)
+        {
+            if (!_search_hook_is_nil())
+            {
+                text.hook = userdef_annotate_item(STASH_LUA_SEARCH_ANNOTATE,
+                                                  &item);
+            }
+            _add_trigrams(text.trigrams, prefix + " " + text.hook
+                                         + text.notes + " " + text.name);
+            _add_trigrams(text.trigrams, text.dump);
+            sort(text.trigrams.begin(), text.trigrams.end());
+            text.trigrams.erase(unique(text.trigrams.begin(),
+                                       text.trigrams.end()),
+                                text.trigrams.end());
+        }
+        entry.items.push_back(text);
+    }
+    return entry;
+}
+
 vector<stash_search_result> Stash::matches_search(
     const string &prefix, const base_pattern &search) const
 {
@@ -445,16 +646,32 @@ vector<stash_search_result> Stash::matches_search(
     if (empty())
         return results;
 
-    for (const item_def &item : items)
+    const stash_search_entry &entry = _search_entry(prefix);
+
+    // A plain text search can pass over items whose texts lack some part
+    // of it, as long as all of those texts are known without asking Lua.
+    const plaintext_pattern *plain =
+        dynamic_cast<const plaintext_pattern *>(&search);
+    vector<uint32_t> wanted;
+    if (plain && entry.hook_cached)
+        _add_trigrams(wanted, plain->tostring());
+
+    for (size_t i = 0; i < items.size(); ++i)
     {
-        const string s   = stash_item_name(item);
-        const string ann = stash_annotate_item(STASH_LUA_SEARCH_ANNOTATE, &item);
-        if (search.matches(prefix + " " + ann + " " + s)
-            || is_dumpable_artefact(item) && search.matches(chardump_desc(item)))
+        const stash_item_text &text = entry.items[i];
+        if (!wanted.empty() && !_has_trigrams(text.trigrams, wanted))
+            continue;
+
+        const string hook = entry.hook_cached
+            ? text.hook
+            : userdef_annotate_item(STASH_LUA_SEARCH_ANNOTATE, &items[i]);
+        const string ann = hook + text.notes;
+        if (search.matches(prefix + " " + ann + " " + text.name)
+            || !text.dump.empty() && search.matches(text.dump))
         {
             stash_search_result res;
-            res.match = s;
-            res.item = item;
+            res.match = text.name;
+            res.item = items[i];
             results.push_back(res);
         }
     }
@@ -485,6 +702,8 @@ void Stash::_update_corpses(int rot_time)
         if (!_is_rottable(item))
             continue;
 
+        _changed();
+
         int new_rot = static_cast<int>(item.stash_freshness) - rot_time;
 
         if (new_rot <= _min_rot(item))
@@ -500,13 +719,17 @@ void Stash::_update_identification()
 {
     for (int i = items.size() - 1; i >= 0; i--)
     {
+        const iflags_t old_flags = items[i].flags;
         god_id_item(items[i]);
         maybe_identify_base_type(items[i]);
+        if (items[i].flags != old_flags)
+            _changed();
     }
 }
 
 void Stash::add_item(const item_def &item, bool add_to_front)
 {
+    _changed();
     if (_is_rottable(item))
         StashTrack.update_corpses();
 
@@ -618,6 +841,7 @@ void Stash::load(reader& inf)
 
     // Zap out item vector, in case it's in use (however unlikely)
     items.clear();
+    _changed();
     // Read in the items
     for (int i = 0; i < count; ++i)
     {
@@ -837,6 +1061,19 @@ void LevelStashes::move_stash(const coord_def& from, const coord_def& to)
     m_stashes.erase(old_pos);
 }
 
+// Moves every Stash on the level by delta.
+void LevelStashes::shift_stashes(const coord_def& delta)
+{
+    stashes_t shifted;
+    for (auto &entry : m_stashes)
+    {
+        Stash &s = entry.second;
+        s.pos += delta;
+        shifted.emplace(s.pos, move(s));
+    }
+    m_stashes.swap(shifted);
+}
+
 // Removes a Stash from the level.
 void LevelStashes::kill_stash(const Stash &s)
 {
@@ -1054,6 +1291,12 @@ void StashTracker::move_stash(const coord_def& from, const coord_def& to)
         lev->move_stash(from, to);
 }
 
+void StashTracker::shift_stashes(const coord_def& delta)
+{
+    if (LevelStashes *lev = find_current_level())
+        lev->shift_stashes(delta);
+}
+
 bool StashTracker::unmark_trapping_nets(const coord_def &c)
 {
     if (LevelStashes *lev = find_current_level())
@@ -1407,6 +1650,10 @@ void StashTracker::get_matching_stashes(
         bool curr_lev)
     const
 {
+    search_context = _search_context();
+    search_hook_cached = _search_hook_cacheable();
+    ++search_serial;
+
     level_id curr = level_id::current();
     for (const auto &entry : levels)
     {
@@ -1417,6 +1664,19 @@ void StashTracker::get_matching_stashes(
             return;
     }
 
+    // Every stash was looked at, so anything not seen this time is gone.
+    if (!curr_lev)
+    {
+        for (auto i = stash_search_cache.begin();
+             i != stash_search_cache.end();)
+        {
+            if (i->second.searched != search_serial)
+                i = stash_search_cache.erase(i);
+            else
+                ++i;
+        }
+    }
+
     for (stash_search_result &result : results)
     {
         int ldist = level_distance(curr, result.pos.id);
@@ -18,6 +18,7 @@ class writer;
 class StashMenu;
 
 struct stash_search_result;
+struct stash_search_entry;
 class Stash
 {
 public:
@@ -65,8 +66,14 @@ private:
     void _update_corpses(int rot_time);
     void _update_identification();
     void add_item(const item_def &item, bool add_to_front = false);
+    void _changed();
+    const stash_search_entry &_search_entry(const string &prefix) const;
 
 private:
+    // Not saved; changes whenever the items do, so that search results
+    // worked out for them can be reused until then.
+    unsigned int version;
+
     bool verified;      // Is this correct to the best of our knowledge?
     coord_def pos;
     dungeon_feature_type feat;
@@ -192,6 +199,7 @@ public:
 
     void  kill_stash(const Stash &s);
     void  move_stash(const coord_def& from, const coord_def& to);
+    void  shift_stashes(const coord_def& delta);
 
     void  save(writer&) const;
     void  load(reader&);
@@ -251,6 +259,7 @@ public:
     // updated.
     bool update_stash(const coord_def& c);
     void move_stash(const coord_def& from, const coord_def& to);
+    void shift_stashes(const coord_def& delta);
 
     // Mark nets at (x,y) on current level as no longer trapping an actor.
     bool unmark_trapping_nets(const coord_def &c);
@@ -331,6 +340,7 @@ string userdef_annotate_item(const char *s, const item_def *item,
                              bool exclusive = false);
 string stash_annotate_item(const char *s, const item_def *item,
                            bool exclusive = false);
+void remember_builtin_stash_hooks();
 
 #define STASH_LUA_SEARCH_ANNOTATE "ch_stash_search_annotate_item"
 #define STASH_LUA_DUMP_ANNOTATE   "ch_stash_dump_annotate_item"
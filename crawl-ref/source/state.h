@@ -59,6 +59,7 @@ struct game_state
     bool arena_suspended;   // Set if the arena has been temporarily
                             // suspended.
     bool generating_level;
+    bool pregen_helper;     // Set in a background level generation process.
 
     bool dump_maps;         // Dump map Lua to stderr on fresh parse.
     bool test;              // Set if we want to run self-tests and exit.
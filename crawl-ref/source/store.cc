@@ -11,7 +11,6 @@
 #include <algorithm>
 
 #include "dlua.h"
-#include "libutil.h" // map_find
 #include "monster.h"
 #include "stringutil.h"
 
@@ -1238,6 +1237,16 @@ CrawlHashTable::CrawlHashTable()
     hash_map = nullptr;
 }
 
+static CrawlHashTable::hash_map_type *
+_copy_hash_map(const CrawlHashTable::hash_map_type &other)
+{
+    auto copy = new CrawlHashTable::hash_map_type();
+    copy->reserve(other.size());
+    for (const auto &entry : other)
+        copy->emplace_back(new CrawlHashTable::value_type(*entry));
+    return copy;
+}
+
 CrawlHashTable::CrawlHashTable(const CrawlHashTable& other)
 {
     if (other.hash_map == nullptr)
@@ -1246,7 +1255,7 @@ CrawlHashTable::CrawlHashTable(const CrawlHashTable& other)
         return;
     }
 
-    hash_map = new hash_map_type(*(other.hash_map));
+    hash_map = _copy_hash_map(*other.hash_map);
 }
 
 CrawlHashTable::~CrawlHashTable()
@@ -1262,6 +1271,9 @@ CrawlHashTable::~CrawlHashTable()
 
 CrawlHashTable &CrawlHashTable::operator = (const CrawlHashTable &other)
 {
+    if (this == &other)
+        return *this;
+
     if (hash_map != nullptr)
         delete hash_map;
 
@@ -1271,7 +1283,7 @@ CrawlHashTable &CrawlHashTable::operator = (const CrawlHashTable &other)
         return *this;
     }
 
-    hash_map = new hash_map_type(*(other.hash_map));
+    hash_map = _copy_hash_map(*other.hash_map);
 
     return *this;
 }
@@ -1291,8 +1303,8 @@ void CrawlHashTable::write(writer &th) const
 
     for (const auto &entry : *hash_map)
     {
-        marshallString(th, entry.first);
-        entry.second.write(th);
+        marshallString(th, entry->first);
+        entry->second.write(th);
     }
 
     ASSERT_VALIDITY();
@@ -1318,6 +1330,7 @@ void CrawlHashTable::read(reader &th)
         return;
 
     init_hash_map();
+    hash_map->reserve(_size);
 
     for (unsigned int i = 0; i < _size; i++)
     {
@@ -1340,14 +1353,29 @@ static map<string, int> accesses;
 //////////////////
 // Misc functions
 
-bool CrawlHashTable::exists(const string &key) const
+static bool _entry_key_less(const unique_ptr<CrawlHashTable::value_type> &entry,
+                            const char *key)
+{
+    return entry->first.compare(key) < 0;
+}
+
+// Returns the entry for key, or where it would be inserted.
+CrawlHashTable::hash_map_type::iterator
+CrawlHashTable::find_entry(const char *key) const
+{
+    return lower_bound(hash_map->begin(), hash_map->end(), key,
+                       _entry_key_less);
+}
+
+bool CrawlHashTable::exists(const char *key) const
 {
     if (!hash_map)
         return false;
 
     ACCESS(key);
     ASSERT_VALIDITY();
-    return hash_map->find(key) != hash_map->end();
+    auto i = find_entry(key);
+    return i != hash_map->end() && (*i)->first == key;
 }
 
 void CrawlHashTable::assert_validity() const
@@ -1362,8 +1390,8 @@ void CrawlHashTable::assert_validity() const
     {
         actual_size++;
 
-        const string          &key = entry.first;
-        const CrawlStoreValue &val = entry.second;
+        const string          &key = entry->first;
+        const CrawlStoreValue &val = entry->second;
 
         ASSERT(!key.empty());
         string trimmed = trimmed_string(key);
@@ -1416,26 +1444,35 @@ void CrawlHashTable::assert_validity() const
 ////////////////////////////////
 // Accessors to contained values
 
-CrawlStoreValue& CrawlHashTable::get_value(const string &key)
+CrawlStoreValue& CrawlHashTable::get_value(const char *key)
 {
     ASSERT_VALIDITY();
     init_hash_map();
 
     ACCESS(key);
     // Inserts CrawlStoreValue() if the key was not found.
-    return (*hash_map)[key];
+    auto i = find_entry(key);
+    if (i == hash_map->end() || (*i)->first != key)
+    {
+        i = hash_map->emplace(i, new value_type(piecewise_construct,
+                                                forward_as_tuple(key),
+                                                forward_as_tuple()));
+    }
+    return (*i)->second;
 }
 
-const CrawlStoreValue& CrawlHashTable::get_value(const string &key) const
+const CrawlStoreValue& CrawlHashTable::get_value(const char *key) const
 {
     ASSERTM(hash_map,
-            "trying to read non-existent property \"%s\"", key.c_str());
+            "trying to read non-existent property \"%s\"", key);
     ASSERT_VALIDITY();
 
     ACCESS(key);
-    CrawlStoreValue *store = map_find(*hash_map, key);
+    auto i = find_entry(key);
+    CrawlStoreValue *store = i != hash_map->end() && (*i)->first == key
+                             ? &(*i)->second : nullptr;
 
-    ASSERTM(store, "trying to read non-existent property \"%s\"", key.c_str());
+    ASSERTM(store, "trying to read non-existent property \"%s\"", key);
     ASSERT(store->type != SV_NONE);
     ASSERT(!(store->flags & SFLAG_UNSET));
 
@@ -1460,18 +1497,18 @@ bool CrawlHashTable::empty() const
     return hash_map->empty();
 }
 
-void CrawlHashTable::erase(const string& key)
+void CrawlHashTable::erase(const char *key)
 {
     ASSERT_VALIDITY();
     init_hash_map();
 
     ACCESS(key);
-    iterator i = hash_map->find(key);
+    auto i = find_entry(key);
 
-    if (i != hash_map->end())
+    if (i != hash_map->end() && (*i)->first == key)
     {
 #ifdef ASSERTS
-        CrawlStoreValue &val = i->second;
+        CrawlStoreValue &val = (*i)->second;
         ASSERT(!(val.flags & SFLAG_NO_ERASE));
 #endif
 
@@ -1494,7 +1531,7 @@ CrawlHashTable::iterator CrawlHashTable::begin()
     ASSERT_VALIDITY();
     init_hash_map();
 
-    return hash_map->begin();
+    return iterator(hash_map->begin());
 }
 
 CrawlHashTable::iterator CrawlHashTable::end()
@@ -1502,7 +1539,7 @@ CrawlHashTable::iterator CrawlHashTable::end()
     ASSERT_VALIDITY();
     init_hash_map();
 
-    return hash_map->end();
+    return iterator(hash_map->end());
 }
 
 CrawlHashTable::const_iterator CrawlHashTable::begin() const
@@ -1510,7 +1547,7 @@ CrawlHashTable::const_iterator CrawlHashTable::begin() const
     ASSERT(hash_map != nullptr);
     ASSERT_VALIDITY();
 
-    return hash_map->begin();
+    return const_iterator(hash_map->cbegin());
 }
 
 CrawlHashTable::const_iterator CrawlHashTable::end() const
@@ -1518,7 +1555,7 @@ CrawlHashTable::const_iterator CrawlHashTable::end() const
     ASSERT(hash_map != nullptr);
     ASSERT_VALIDITY();
 
-    return hash_map->end();
+    return const_iterator(hash_map->cend());
 }
 
 void CrawlHashTable::init_hash_map()
@@ -8,7 +8,9 @@
 #define STORE_H
 
 #include <climits>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -255,9 +257,50 @@ public:
 
     ~CrawlHashTable();
 
-    typedef map<string, CrawlStoreValue>  hash_map_type;
-    typedef hash_map_type::iterator       iterator;
-    typedef hash_map_type::const_iterator const_iterator;
+    typedef pair<const string, CrawlStoreValue> value_type;
+
+    // Entries are kept sorted by key in a flat vector, which is cheaper
+    // than a map for the handful of keys most tables hold. Each entry is
+    // allocated separately so that references to values stay valid as
+    // other keys are added, just as they would in a map.
+    typedef vector<unique_ptr<value_type>>      hash_map_type;
+
+    // Iterates over entries in key order, like a std::map iterator.
+    template <typename Base, typename Value>
+    class entry_iterator
+    {
+    public:
+        typedef bidirectional_iterator_tag iterator_category;
+        typedef Value                      value_type;
+        typedef ptrdiff_t                  difference_type;
+        typedef Value*                     pointer;
+        typedef Value&                     reference;
+
+        entry_iterator() : base() { }
+        entry_iterator(Base b) : base(b) { }
+        template <typename B, typename V>
+        entry_iterator(const entry_iterator<B, V> &other) : base(other.base)
+        { }
+
+        Value &operator*() const { return **base; }
+        Value *operator->() const { return base->get(); }
+
+        entry_iterator &operator++() { ++base; return *this; }
+        entry_iterator &operator--() { --base; return *this; }
+        entry_iterator operator++(int) { return entry_iterator(base++); }
+        entry_iterator operator--(int) { return entry_iterator(base--); }
+
+        bool operator==(const entry_iterator &other) const
+        { return base == other.base; }
+        bool operator!=(const entry_iterator &other) const
+        { return base != other.base; }
+
+        Base base;
+    };
+
+    typedef entry_iterator<hash_map_type::iterator, value_type> iterator;
+    typedef entry_iterator<hash_map_type::const_iterator, const value_type>
+        const_iterator;
 
 protected:
     // NOTE: Not using auto_ptr because making hash_map an auto_ptr
@@ -265,6 +308,7 @@ protected:
     hash_map_type *hash_map;
 
     void init_hash_map();
+    hash_map_type::iterator find_entry(const char *key) const;
 
     friend class CrawlStoreValue;
 
@@ -274,18 +318,20 @@ public:
     void write(writer &) const;
     void read(reader &);
 
-    bool exists(const string &key) const;
+    // Keys given as C strings are looked up without building a string.
+    bool exists(const char *key) const;
+    bool exists(const string &key) const { return exists(key.c_str()); }
     void assert_validity() const;
 
     // NOTE: If the const versions of get_value() or [] are given a
     // key which doesn't exist, they will assert.
-    const CrawlStoreValue& get_value(const string &key) const;
-    const CrawlStoreValue& get_value(const char *key) const
-    { return get_value(string(key)); }
+    const CrawlStoreValue& get_value(const char *key) const;
+    const CrawlStoreValue& get_value(const string &key) const
+    { return get_value(key.c_str()); }
     const CrawlStoreValue& operator[] (const string &key) const
-    { return get_value(key); }
+    { return get_value(key.c_str()); }
     const CrawlStoreValue& operator[] (const char *key) const
-    { return get_value(string(key)); }
+    { return get_value(key); }
 
     // NOTE: If get_value() or [] is given a key which doesn't exist
     // in the table, an unset/empty CrawlStoreValue will be created
@@ -294,20 +340,20 @@ public:
     // hash table has a type (rather than being heterogeneous)
     // then trying to assign a different type to the CrawlStoreValue
     // will assert.
-    CrawlStoreValue& get_value(const string &key);
-    CrawlStoreValue& get_value(const char *key)
-    { return get_value(string(key)); }
+    CrawlStoreValue& get_value(const char *key);
+    CrawlStoreValue& get_value(const string &key)
+    { return get_value(key.c_str()); }
     CrawlStoreValue& operator[] (const string &key)
-    { return get_value(key); }
+    { return get_value(key.c_str()); }
     CrawlStoreValue& operator[] (const char *key)
-    { return get_value(string(key)); }
+    { return get_value(key); }
 
     // std::map style interface
     unsigned int size() const;
     bool      empty() const;
 
-    void      erase(const string& key);
-    void      erase(const char *key) { erase(string(key)); }
+    void      erase(const char *key);
+    void      erase(const string& key) { erase(key.c_str()); }
     void      clear();
 
     const_iterator begin() const;
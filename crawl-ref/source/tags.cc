@@ -2324,6 +2324,7 @@ static void tag_read_you(reader &th)
         you.melded.set(i, unmarshallBoolean(th));
     for (int i = count; i < NUM_EQUIP; ++i)
         you.melded.set(i, false);
+    you.artefacts_changed();
 
     you.magic_points              = unmarshallUByte(th);
     you.max_magic_points          = unmarshallByte(th);
@@ -3861,6 +3862,98 @@ static void tag_read_you_dungeon(reader &th)
     read_level_connectivity(th);
 }
 
+// you.props entries that level generation reads or consumes.
+static const char *_levelgen_prop_keys[] =
+{
+    TEMPLE_GODS_KEY, OVERFLOW_TEMPLES_KEY, TEMPLE_MAP_KEY, TEMPLE_SIZE_KEY,
+    "force_map", "force_minivault",
+};
+
+// The parts of the player and dungeon state that building a persistent
+// level reads or changes. A level built in the background is only used if
+// this was the same when it was built, and the state it left behind is
+// then carried over with unmarshall_levelgen_state(). The gold it generated
+// and the monster ids it used are carried over by files.cc.
+void marshall_levelgen_state(writer &th)
+{
+    marshallInt(th, you.game_seeds[SEED_LEVELGEN]);
+    marshallByte(th, you.species);
+    // Whether RANDOM_COMPATIBLE_MONSTER allies would be angered.
+    marshallByte(th, you.religion);
+    marshallByte(th, you.mutation[MUT_NO_LOVE]);
+
+    marshallFixedBitVector<NUM_MONSTERS>(th, you.unique_creatures);
+    marshallUByte(th, MAX_UNRANDARTS);
+    for (int j = 0; j < MAX_UNRANDARTS; ++j)
+        marshallByte(th, you.unique_items[j]);
+    marshallUByte(th, you.octopus_king_rings);
+
+    marshall_iterator(th, you.uniq_map_tags.begin(), you.uniq_map_tags.end(),
+                      marshallString);
+    marshall_iterator(th, you.uniq_map_names.begin(), you.uniq_map_names.end(),
+                      marshallString);
+    marshallMap(th, you.vault_list, marshall_level_id, marshallStringVector);
+
+    CrawlHashTable props;
+    for (const char *key : _levelgen_prop_keys)
+        if (you.props.exists(key))
+            props[key] = you.props[key];
+    props.write(th);
+
+    if (!dlua.callfn("dgn_save_data", "u", &th))
+        mprf(MSGCH_ERROR, "Failed to save Lua data: %s", dlua.error.c_str());
+}
+
+void unmarshall_levelgen_state(reader &th)
+{
+    // Only read by level generation, never changed by it.
+    unmarshallInt(th);
+    unmarshallByte(th);
+    unmarshallByte(th);
+    unmarshallByte(th);
+
+    unmarshallFixedBitVector<NUM_MONSTERS>(th, you.unique_creatures);
+    const int count = unmarshallUByte(th);
+    ASSERT(count == MAX_UNRANDARTS);
+    for (int j = 0; j < MAX_UNRANDARTS; ++j)
+    {
+        you.unique_items[j] =
+            static_cast<unique_item_status_type>(unmarshallByte(th));
+    }
+    you.octopus_king_rings = unmarshallUByte(th);
+
+    typedef pair<string_set::iterator, bool> ssipair;
+    you.uniq_map_tags.clear();
+    unmarshall_container(th, you.uniq_map_tags,
+                         (ssipair (string_set::*)(const string &))
+                         &string_set::insert,
+                         unmarshallString);
+    you.uniq_map_names.clear();
+    unmarshall_container(th, you.uniq_map_names,
+                         (ssipair (string_set::*)(const string &))
+                         &string_set::insert,
+                         unmarshallString);
+    you.vault_list.clear();
+    unmarshallMap(th, you.vault_list, unmarshall_level_id,
+                  unmarshallStringVector);
+
+    CrawlHashTable props;
+    props.read(th);
+    for (const char *key : _levelgen_prop_keys)
+    {
+        if (props.exists(key))
+            you.props[key] = props[key];
+        else
+            you.props.erase(key);
+    }
+
+    if (!dlua.callfn("dgn_load_data", "u", &th))
+    {
+        mprf(MSGCH_ERROR, "Failed to load Lua persist table: %s",
+             dlua.error.c_str());
+    }
+}
+
 static void tag_read_lost_monsters(reader &th)
 {
     the_lost_ones.clear();
@@ -3933,9 +4026,8 @@ static void tag_construct_level(writer &th)
 
     // how many clouds?
     marshallShort(th, env.cloud.size());
-    for (const auto& entry : env.cloud)
+    for (const cloud_struct& cloud : env.cloud)
     {
-        const cloud_struct& cloud = entry.second;
         marshallByte(th, cloud.type);
         ASSERT(cloud.type != CLOUD_NONE);
         ASSERT_IN_BOUNDS(cloud.pos);
@@ -4596,7 +4688,7 @@ void marshallMapCell(writer &th, const map_cell &cell)
 
     if (flags & MAP_SERIALIZE_CLOUD)
     {
-        cloud_info* ci = cell.cloudinfo();
+        const cloud_info* ci = cell.cloudinfo();
         marshallUnsigned(th, ci->type);
         marshallUnsigned(th, ci->colour);
         marshallUnsigned(th, ci->duration);
@@ -4789,8 +4881,8 @@ void marshallMonster(writer &th, const monster& m)
     marshallInt(th, m.experience);
 
     marshallShort(th, m.enchantments.size());
-    for (const auto &entry : m.enchantments)
-        marshall_mon_enchant(th, entry.second);
+    for (const mon_enchant &entry : m.enchantments)
+        marshall_mon_enchant(th, entry);
     marshallByte(th, m.ench_countdown);
 
     marshallShort(th, min(m.hit_points, MAX_MONSTER_HP));
@@ -5316,10 +5408,10 @@ static void tag_read_level(reader &th)
 
             unmarshallMapCell(th, env.map_knowledge[i][j]);
             // Fixup positions
-            if (env.map_knowledge[i][j].monsterinfo())
-                env.map_knowledge[i][j].monsterinfo()->pos = coord_def(i, j);
-            if (env.map_knowledge[i][j].cloudinfo())
-                env.map_knowledge[i][j].cloudinfo()->pos = coord_def(i, j);
+            if (monster_info *mi = env.map_knowledge[i][j].edit_monsterinfo())
+                mi->pos = coord_def(i, j);
+            if (cloud_info *ci = env.map_knowledge[i][j].edit_cloudinfo())
+                ci->pos = coord_def(i, j);
 
             env.map_knowledge[i][j].flags &= ~MAP_VISIBLE_FLAG;
             if (env.map_knowledge[i][j].seen())
@@ -5382,7 +5474,7 @@ static void tag_read_level(reader &th)
         // 0.18-a0-629-g16988c9.
         if (!cell_is_solid(cloud.pos))
 #endif
-            env.cloud[cloud.pos] = cloud;
+            env.cloud.set(cloud.pos, cloud);
     }
 
     EAT_CANARY;
@@ -5514,6 +5606,7 @@ static void tag_read_level_items(reader &th)
         unmarshallItem(th, mitm[i]);
     for (int i = item_count; i < MAX_ITEMS; ++i)
         mitm[i].clear();
+    mitm_slot_freed(0);
 
 #ifdef DEBUG_ITEM_SCAN
     // There's no way to fix this, even with wizard commands, so get
@@ -5594,8 +5687,7 @@ void unmarshallMonster(reader &th, monster& m)
     for (int i = 0; i < nenchs; ++i)
     {
         mon_enchant me = unmarshall_mon_enchant(th);
-        m.enchantments[me.ench] = me;
-        m.ench_cache.set(me.ench, true);
+        m.enchantments.set(me);
     }
     m.ench_countdown = unmarshallByte(th);
 
@@ -170,6 +170,9 @@ void tag_read(reader &inf, tag_type tag_id);
 void tag_write(tag_type tagID, writer &outf);
 void tag_read_char(reader &th, uint8_t format, uint8_t major, uint8_t minor);
 
+void marshall_levelgen_state(writer &th);
+void unmarshall_levelgen_state(reader &th);
+
 /* ***********************************************************************
  * misc
  * *********************************************************************** */
@@ -1864,6 +1864,8 @@ const char* feat_type_name(dungeon_feature_type feat)
 
 void set_terrain_changed(const coord_def p)
 {
+    travel_map_changed(p);
+
     if (cell_is_solid(p))
         delete_cloud(p);
 
@@ -1379,7 +1379,7 @@ void tile_apply_properties(const coord_def &gc, packed_cell &cell)
         cell.halo = HALO_UMBRA;
     else if (mc.flags & MAP_HALOED)
     {
-        monster_info* mon = mc.monsterinfo();
+        const monster_info* mon = mc.monsterinfo();
         if (mon && mons_class_gives_xp(mon->type))
         {
             cell.halo = HALO_MONSTER;
@@ -64,8 +64,15 @@ static unsigned int get_milliseconds()
 
 TilesFramework tiles;
 
+// How much output may wait for a slow destination before it is skipped
+// ahead and sent the whole game state again instead.
+static const size_t MAX_OUTPUT_BACKLOG = 2 * 1024 * 1024;
+
 TilesFramework::TilesFramework()
     : m_crt_mode(CRT_NORMAL),
+      m_out_seq(0),
+      m_out_bytes(0),
+      m_need_resync(false),
       m_controlled_from_web(false),
       m_last_ui_state(UI_INIT),
       m_view_loaded(false),
@@ -90,6 +97,15 @@ TilesFramework::~TilesFramework()
 
 void TilesFramework::shutdown()
 {
+    // Give the last messages (such as the exit reason) up to five seconds
+    // to get out.
+    for (int tries = 50; tries > 0 && !m_out_queue.empty(); --tries)
+    {
+        _send_output();
+        if (!m_out_queue.empty())
+            usleep(100 * 1000);
+    }
+
     close(m_sock);
     remove(m_sock_name.c_str());
 }
@@ -116,12 +132,6 @@ bool TilesFramework::initialise()
     // Need small maximum message size to avoid crashes in OS X
     m_max_msg_size = 2048;
 
-    struct timeval tv;
-    tv.tv_sec = 1;
-    tv.tv_usec = 0;
-    if (setsockopt(m_sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) < 0)
-        die("Can't set send timeout!");
-
     if (m_await_connection)
         _await_connection();
 
@@ -145,20 +155,31 @@ string TilesFramework::get_message()
     return m_msg_buf;
 }
 
-void TilesFramework::write_message(const char *format, ...)
+/**
+ * Format straight onto the end of the message buffer, growing it to fit.
+ */
+void TilesFramework::_vwrite_message(const char *format, va_list argp)
 {
-    char buf[2048];
-    int len;
+    va_list args;
+    va_copy(args, argp);
+    const int len = vsnprintf(nullptr, 0, format, args);
+    va_end(args);
+    if (len < 0)
+        die("Webtiles message format error! (%s)", format);
 
+    const size_t old_size = m_msg_buf.size();
+    // vsnprintf also writes the terminating NUL.
+    m_msg_buf.resize(old_size + len + 1);
+    vsnprintf(&m_msg_buf[old_size], len + 1, format, argp);
+    m_msg_buf.resize(old_size + len);
+}
+
+void TilesFramework::write_message(const char *format, ...)
+{
     va_list argp;
     va_start(argp, format);
-    if ((len = vsnprintf(buf, sizeof(buf), format, argp)) < 0)
-        die("Webtiles message format error! (%s)", format);
-    else if (len >= (int)sizeof(buf))
-        die("Webtiles message too long! (%d)", len);
+    _vwrite_message(format, argp);
     va_end(argp);
-
-    m_msg_buf.append(buf);
 }
 
 void TilesFramework::finish_message()
@@ -167,77 +188,111 @@ void TilesFramework::finish_message()
         return;
 
     m_msg_buf.append("\n");
-    const char* fragment_start = m_msg_buf.data();
-    const char* data_end = m_msg_buf.data() + m_msg_buf.size();
-    while (fragment_start < data_end)
+    if (!m_dest_addrs.empty())
     {
-        int fragment_size = data_end - fragment_start;
-        if (fragment_size > m_max_msg_size)
-            fragment_size = m_max_msg_size;
+        for (size_t start = 0; start < m_msg_buf.size();
+             start += m_max_msg_size)
+        {
+            m_out_queue.push_back({ m_msg_buf.substr(start, m_max_msg_size),
+                                    start + m_max_msg_size
+                                        >= m_msg_buf.size() });
+            m_out_bytes += m_out_queue.back().data.size();
+        }
+    }
+    m_msg_buf.clear();
+    m_need_flush = true;
 
-        for (unsigned int i = 0; i < m_dest_addrs.size(); ++i)
+    _send_output();
+}
+
+/**
+ * Send each destination as much of the output queue as its socket will
+ * take without blocking.
+ */
+void TilesFramework::_send_output()
+{
+    const unsigned int queue_end = m_out_seq + m_out_queue.size();
+    for (unsigned int i = 0; i < m_dest_addrs.size(); ++i)
+    {
+        OutputDest &dest = m_dest_addrs[i];
+        while (dest.next < queue_end)
         {
-            int retries = 30;
-            ssize_t sent = 0;
-            while (sent < fragment_size)
+            const OutputFragment &frag = m_out_queue[dest.next - m_out_seq];
+            ssize_t retval = sendto(m_sock, frag.data.data(), frag.data.size(),
+                                    MSG_DONTWAIT, (sockaddr*) &dest.addr,
+                                    sizeof(sockaddr_un));
+            if (retval > 0)
             {
-                ssize_t retval = sendto(m_sock, fragment_start + sent,
-                    fragment_size - sent, 0, (sockaddr*) &m_dest_addrs[i],
-                    sizeof(sockaddr_un));
-                if (retval <= 0)
-                {
-                    const char *errmsg = retval == 0 ? "No bytes sent"
-                                                     : strerror(errno);
-                    if (--retries <= 0)
-                        die("Socket write error: %s", errmsg);
+                dest.next++;
+                dest.mid_message = !frag.ends_message;
+            }
+            else if (retval < 0 && errno == EINTR)
+                continue;
+            else if (retval == 0 || errno == ENOBUFS || errno == EWOULDBLOCK
+                     || errno == EAGAIN)
+            {
+                // Full for now; try again later.
+                break;
+            }
+            else if (errno == ECONNREFUSED || errno == ENOENT)
+            {
+                // the other side is dead
+                m_dest_addrs.erase(m_dest_addrs.begin() + i);
+                i--;
+                break;
+            }
+            else
+                die("Socket write error: %s", strerror(errno));
+        }
+    }
 
-                    if (retval == 0 || errno == ENOBUFS || errno == EWOULDBLOCK
-                        || errno == EINTR || errno == EAGAIN)
-                    {
-                        // Wait for half a second at first (up to five), then
-                        // try again.
-                        usleep(retries <= 10 ? 5000 * 1000 : 500 * 1000);
-                    }
-                    else if (errno == ECONNREFUSED || errno == ENOENT)
-                    {
-                        // the other side is dead
-                        m_dest_addrs.erase(m_dest_addrs.begin() + i);
-                        i--;
-                        break;
-                    }
-                    else
-                        die("Socket write error: %s", errmsg);
-                }
-                else
-                    sent += retval;
+    _trim_output();
+}
+
+/**
+ * Drop output every destination has been sent. If what is left is still
+ * too much, skip destinations that are between messages to the end of the
+ * queue and have the whole game state sent again once they catch up.
+ */
+void TilesFramework::_trim_output()
+{
+    const unsigned int queue_end = m_out_seq + m_out_queue.size();
+    if (m_out_bytes > MAX_OUTPUT_BACKLOG)
+    {
+        for (OutputDest &dest : m_dest_addrs)
+            if (dest.next < queue_end && !dest.mid_message)
+            {
+                dest.next = queue_end;
+                dest.needs_resync = true;
             }
+    }
+
+    unsigned int done = queue_end;
+    for (OutputDest &dest : m_dest_addrs)
+    {
+        done = min(done, dest.next);
+        if (dest.needs_resync && dest.next == queue_end)
+        {
+            dest.needs_resync = false;
+            m_need_resync = true;
         }
+    }
 
-        fragment_start += fragment_size;
+    while (m_out_seq < done)
+    {
+        m_out_bytes -= m_out_queue.front().data.size();
+        m_out_queue.pop_front();
+        m_out_seq++;
     }
-    m_msg_buf.clear();
-    m_need_flush = true;
 }
 
 void TilesFramework::send_message(const char *format, ...)
 {
-    char buf[2048];
-    int len;
-
     va_list argp;
     va_start(argp, format);
-    if ((len = vsnprintf(buf, sizeof(buf), format, argp)) >= (int)sizeof(buf)
-        || len == -1)
-    {
-        if (len == -1)
-            die("Webtiles message format error! (%s)", format);
-        else
-            die("Webtiles message too long! (%d)", len);
-    }
+    _vwrite_message(format, argp);
     va_end(argp);
 
-    m_msg_buf.append(buf);
-
     finish_message();
 }
 
@@ -252,7 +307,7 @@ void TilesFramework::flush_messages()
 
 void TilesFramework::_await_connection()
 {
-    while (m_dest_addrs.size() == 0)
+    while (m_dest_addrs.empty())
         _receive_control_message();
 }
 
@@ -299,7 +354,10 @@ wint_t TilesFramework::_handle_control_message(sockaddr_un addr, string data)
         JsonWrapper primary = json_find_member(obj.node, "primary");
         primary.check(JSON_BOOL);
 
-        m_dest_addrs.push_back(addr);
+        m_dest_addrs.push_back({ addr,
+                                 m_out_seq
+                                    + (unsigned int) m_out_queue.size(),
+                                 false, false });
         m_controlled_from_web = primary->bool_;
     }
     else if (msgtype == "key")
@@ -365,8 +423,19 @@ bool TilesFramework::await_input(wint_t& c, bool block)
 
             if (block)
             {
+                if (m_need_resync)
+                {
+                    m_need_resync = false;
+                    _send_everything();
+                }
                 tiles.flush_messages();
-                result = select(maxfd + 1, &fds, nullptr, nullptr, nullptr);
+
+                // While output is waiting, wake up now and then to send more.
+                timeval retry;
+                retry.tv_sec = 0;
+                retry.tv_usec = 100 * 1000;
+                result = select(maxfd + 1, &fds, nullptr, nullptr,
+                                m_out_queue.empty() ? nullptr : &retry);
             }
             else
             {
@@ -379,7 +448,9 @@ bool TilesFramework::await_input(wint_t& c, bool block)
         }
         while (result == -1 && errno == EINTR);
 
-        if (result == 0)
+        if (result == 0 && block)
+            _send_output();
+        else if (result == 0)
             return false;
         else if (result > 0)
         {
@@ -1302,6 +1373,270 @@ void TilesFramework::_send_cell(const coord_def &gc,
     json_close_object(true);
 }
 
+// Fields of a packed map cell, in the order they are written. Keep in sync
+// with packed_fields in map_knowledge.js.
+enum packed_cell_field
+{
+    PCF_FEAT,
+    PCF_MAP_FEAT,
+    PCF_GLYPH,
+    PCF_COLOUR,
+    PCF_FG,
+    PCF_BG,
+    PCF_CLOUD,
+    PCF_BLOODY,
+    PCF_OLD_BLOOD,
+    PCF_SILENCED,
+    PCF_HALO,
+    PCF_MOLDY,
+    PCF_GLOWING_MOLD,
+    PCF_SANCTUARY,
+    PCF_LIQUEFIED,
+    PCF_ORB_GLOW,
+    PCF_QUAD_GLOW,
+    PCF_DISJUNCT,
+    PCF_MANGROVE_WATER,
+    PCF_BLOOD_ROTATION,
+    PCF_TRAVEL_TRAIL,
+    PCF_HEAT_AURA,
+    PCF_FLAVOUR,
+    PCF_OVERLAYS,
+};
+
+/**
+ * Writes map cells as a compact byte string instead of JSON objects.
+ *
+ * Each cell is the gap since the previous cell's grid index, a bit mask of
+ * the fields that changed and then those fields' values, all as varints.
+ * Tile indices go into a dictionary the first time they appear in a frame
+ * and are referred to by position after that. Only cells without monsters
+ * or dolls are packed; the rest still go out as JSON.
+ */
+class map_cell_packer
+{
+public:
+    map_cell_packer() : last_index(-1), fields(0), next_field(0) {}
+
+    bool empty() const { return out.empty(); }
+
+    void start_cell()
+    {
+        body.clear();
+        fields = 0;
+        next_field = 0;
+    }
+
+    // Fields must be given in packed_cell_field order.
+    void field(packed_cell_field f)
+    {
+        ASSERT(f >= next_field);
+        fields |= 1 << f;
+        next_field = f + 1;
+    }
+
+    void write_uint(uint32_t v)
+    {
+        while (v >= 0x80)
+        {
+            body.push_back(static_cast<char>((v & 0x7F) | 0x80));
+            v >>= 7;
+        }
+        body.push_back(static_cast<char>(v));
+    }
+
+    void write_int(int v)
+    {
+        write_uint((static_cast<uint32_t>(v) << 1) ^ (v < 0 ? ~0u : 0u));
+    }
+
+    void write_bool(bool v)
+    {
+        write_uint(v);
+    }
+
+    void write_tileidx(tileidx_t t)
+    {
+        auto it = tiles.find(t);
+        if (it != tiles.end())
+        {
+            write_uint(it->second << 1 | 1);
+            return;
+        }
+        write_uint(0);
+        write_uint(t & 0xFFFFFFFF);
+        write_uint(t >> 32);
+        const int index = tiles.size();
+        tiles[t] = index;
+    }
+
+    // Returns false, writing nothing, if no field changed.
+    bool finish_cell(int index)
+    {
+        if (!fields)
+            return false;
+
+        swap(out_body, body);
+        body.clear();
+        write_uint(index - last_index - 1);
+        write_uint(fields);
+        out += body;
+        out += out_body;
+        last_index = index;
+        return true;
+    }
+
+    string base64() const
+    {
+        static const char digits[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        string encoded;
+        encoded.reserve((out.size() + 2) / 3 * 4);
+        for (size_t i = 0; i < out.size(); i += 3)
+        {
+            const size_t n = min<size_t>(3, out.size() - i);
+            uint32_t v = static_cast<uint8_t>(out[i]) << 16;
+            if (n > 1)
+                v |= static_cast<uint8_t>(out[i + 1]) << 8;
+            if (n > 2)
+                v |= static_cast<uint8_t>(out[i + 2]);
+            encoded += digits[v >> 18 & 0x3F];
+            encoded += digits[v >> 12 & 0x3F];
+            encoded += n > 1 ? digits[v >> 6 & 0x3F] : '=';
+            encoded += n > 2 ? digits[v & 0x3F] : '=';
+        }
+        return encoded;
+    }
+
+private:
+    string out, body, out_body;
+    map<tileidx_t, int> tiles;
+    int last_index;
+    uint32_t fields;
+    int next_field;
+};
+
+static bool _can_pack_cell(const screen_cell_t &next_sc,
+                           const map_cell &current_mc,
+                           const map_cell &next_mc)
+{
+    return !current_mc.monsterinfo() && !next_mc.monsterinfo()
+           && (next_sc.tile.fg & TILE_FLAG_MASK) < TILE_MAIN_MAX;
+}
+
+// The packed equivalent of TilesFramework::_send_cell() for cells that
+// _can_pack_cell() accepts.
+static void _pack_cell(map_cell_packer &packer,
+                       const screen_cell_t &current_sc,
+                       const screen_cell_t &next_sc,
+                       const map_cell &current_mc, const map_cell &next_mc,
+                       bool force_full)
+{
+    if (current_mc.feat() != next_mc.feat())
+    {
+        packer.field(PCF_FEAT);
+        packer.write_int(next_mc.feat());
+    }
+
+    const map_feature mf = get_cell_map_feature(next_mc);
+    if (get_cell_map_feature(current_mc) != mf)
+    {
+        packer.field(PCF_MAP_FEAT);
+        packer.write_int(mf);
+    }
+
+    const ucs_t glyph = next_sc.glyph;
+    if (current_sc.glyph != glyph)
+    {
+        packer.field(PCF_GLYPH);
+        packer.write_uint(glyph);
+    }
+    if ((current_sc.colour != next_sc.colour
+         || current_sc.glyph == ' ') && glyph != ' ')
+    {
+        int col = next_sc.colour;
+        col = (_get_brand(col) << 4) | macro_colour(col & 0xF);
+        packer.field(PCF_COLOUR);
+        packer.write_int(col);
+    }
+
+    const packed_cell &next_pc = next_sc.tile;
+    const packed_cell &current_pc = current_sc.tile;
+
+    if (next_pc.fg != current_pc.fg)
+    {
+        const tileidx_t fg_idx = next_pc.fg & TILE_FLAG_MASK;
+        packer.field(PCF_FG);
+        packer.write_tileidx(next_pc.fg);
+        // The known base item plus one, or zero for none.
+        packer.write_uint(fg_idx ? tileidx_known_base_item(fg_idx) + 1 : 0);
+    }
+
+    if (next_pc.bg != current_pc.bg)
+    {
+        packer.field(PCF_BG);
+        packer.write_tileidx(next_pc.bg);
+    }
+
+    if (next_pc.cloud != current_pc.cloud)
+    {
+        packer.field(PCF_CLOUD);
+        packer.write_tileidx(next_pc.cloud);
+    }
+
+#define PACK_CHANGED(field_id, member, writer)           \
+    if (next_pc.member != current_pc.member)             \
+    {                                                    \
+        packer.field(field_id);                          \
+        packer.writer(next_pc.member);                   \
+    }
+
+    PACK_CHANGED(PCF_BLOODY, is_bloody, write_bool);
+    PACK_CHANGED(PCF_OLD_BLOOD, old_blood, write_bool);
+    PACK_CHANGED(PCF_SILENCED, is_silenced, write_bool);
+    PACK_CHANGED(PCF_HALO, halo, write_int);
+    PACK_CHANGED(PCF_MOLDY, is_moldy, write_bool);
+    PACK_CHANGED(PCF_GLOWING_MOLD, glowing_mold, write_bool);
+    PACK_CHANGED(PCF_SANCTUARY, is_sanctuary, write_bool);
+    PACK_CHANGED(PCF_LIQUEFIED, is_liquefied, write_bool);
+    PACK_CHANGED(PCF_ORB_GLOW, orb_glow, write_int);
+    PACK_CHANGED(PCF_QUAD_GLOW, quad_glow, write_bool);
+    PACK_CHANGED(PCF_DISJUNCT, disjunct, write_bool);
+    PACK_CHANGED(PCF_MANGROVE_WATER, mangrove_water, write_bool);
+    PACK_CHANGED(PCF_BLOOD_ROTATION, blood_rotation, write_int);
+    PACK_CHANGED(PCF_TRAVEL_TRAIL, travel_trail, write_int);
+#if TAG_MAJOR_VERSION == 34
+    PACK_CHANGED(PCF_HEAT_AURA, heat_aura, write_int);
+#endif
+#undef PACK_CHANGED
+
+    if (_needs_flavour(next_pc) &&
+        (next_pc.flv.floor != current_pc.flv.floor
+         || next_pc.flv.special != current_pc.flv.special
+         || !_needs_flavour(current_pc)
+         || force_full))
+    {
+        packer.field(PCF_FLAVOUR);
+        packer.write_int(next_pc.flv.floor);
+        packer.write_int(next_pc.flv.special);
+    }
+
+    bool overlays_changed =
+        next_pc.num_dngn_overlay != current_pc.num_dngn_overlay;
+    for (int i = 0; !overlays_changed && i < next_pc.num_dngn_overlay; i++)
+    {
+        overlays_changed =
+            next_pc.dngn_overlay[i] != current_pc.dngn_overlay[i];
+    }
+
+    if (overlays_changed)
+    {
+        packer.field(PCF_OVERLAYS);
+        packer.write_uint(next_pc.num_dngn_overlay);
+        for (int i = 0; i < next_pc.num_dngn_overlay; ++i)
+            packer.write_int(next_pc.dngn_overlay[i]);
+    }
+}
+
 void TilesFramework::_send_cursor(cursor_type type)
 {
     if (m_cursor[type] == NO_CURSOR)
@@ -1377,6 +1712,7 @@ void TilesFramework::_send_map(bool force_full)
 
     coord_def last_gc(0, 0);
     bool send_gc = true;
+    map_cell_packer packer;
 
     json_open_array("cells");
     for (int y = 0; y < GYM; y++)
@@ -1401,6 +1737,20 @@ void TilesFramework::_send_map(bool force_full)
             if (m_origin.equals(-1, -1))
                 m_origin = gc;
 
+            const screen_cell_t& sc = force_full ? default_cell
+                : m_current_view(gc);
+            const map_cell& mc = force_full ? default_map_cell
+                : m_current_map_knowledge(gc);
+
+            if (_can_pack_cell(m_next_view(gc), mc, env.map_knowledge(gc)))
+            {
+                packer.start_cell();
+                _pack_cell(packer, sc, m_next_view(gc),
+                           mc, env.map_knowledge(gc), force_full);
+                packer.finish_cell(y * GXM + x);
+                continue;
+            }
+
             json_open_object();
             if (send_gc
                 || last_gc.x + 1 != gc.x
@@ -1411,10 +1761,6 @@ void TilesFramework::_send_map(bool force_full)
                 json_treat_as_empty();
             }
 
-            const screen_cell_t& sc = force_full ? default_cell
-                : m_current_view(gc);
-            const map_cell& mc = force_full ? default_map_cell
-                : m_current_map_knowledge(gc);
             _send_cell(gc,
                        sc,
                        m_next_view(gc),
@@ -1430,6 +1776,16 @@ void TilesFramework::_send_map(bool force_full)
         }
     json_close_array(true);
 
+    if (!packer.empty())
+    {
+        json_open_object("packed");
+        json_write_int("w", GXM);
+        json_write_int("ox", m_origin.x);
+        json_write_int("oy", m_origin.y);
+        json_write_string("cells", packer.base64());
+        json_close_object();
+    }
+
     json_close_object(true);
 
     finish_message();
@@ -1940,23 +2296,34 @@ bool TilesFramework::cell_needs_redraw(const coord_def& gc)
 
 void TilesFramework::write_message_escaped(const string& s)
 {
+    static const char hex[] = "0123456789abcdef";
+
     m_msg_buf.reserve(m_msg_buf.size() + s.size());
 
-    for (unsigned char c : s)
+    const char *run = s.data();
+    const char *end = run + s.size();
+    for (const char *p = run; p < end; ++p)
     {
+        const unsigned char c = *p;
+        if (c != '"' && c != '\\' && c >= 0x20)
+            continue;
+
+        // Copy the run of characters that need no escaping in one go.
+        m_msg_buf.append(run, p - run);
+        run = p + 1;
+
         if (c == '"')
-            m_msg_buf.append("\\\"");
+            m_msg_buf.append("\\\"", 2);
         else if (c == '\\')
-            m_msg_buf.append("\\\\");
-        else if (c < 0x20)
+            m_msg_buf.append("\\\\", 2);
+        else
         {
-            char buf[7];
-            snprintf(buf, sizeof(buf), "\\u%04x", c);
-            m_msg_buf.append(buf);
+            const char escaped[] =
+                { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+            m_msg_buf.append(escaped, sizeof(escaped));
         }
-        else
-            m_msg_buf.append(1, c);
     }
+    m_msg_buf.append(run, end - run);
 }
 
 void TilesFramework::json_open(const string& name, char opener, char type)
@@ -2034,25 +2401,37 @@ void TilesFramework::json_close_array(bool erase_if_empty)
 void TilesFramework::json_write_comma()
 {
     if (m_msg_buf.empty()) return;
-    char last = m_msg_buf[m_msg_buf.size() - 1];
+    char last = m_msg_buf.back();
     if (last == '{' || last == '[' || last == ',' || last == ':') return;
-    write_message(",");
+    m_msg_buf.push_back(',');
 }
 
 void TilesFramework::json_write_name(const string& name)
 {
     json_write_comma();
 
-    write_message("\"");
+    m_msg_buf.push_back('"');
     write_message_escaped(name);
-    write_message("\":");
+    m_msg_buf.append("\":", 2);
 }
 
 void TilesFramework::json_write_int(int value)
 {
     json_write_comma();
 
-    write_message("%d", value);
+    // Same output as "%d", without going through printf.
+    char buf[12];
+    char *p = buf + sizeof(buf);
+    unsigned int u = value < 0 ? -(unsigned int) value : value;
+    do
+    {
+        *--p = '0' + u % 10;
+        u /= 10;
+    }
+    while (u);
+    if (value < 0)
+        *--p = '-';
+    m_msg_buf.append(p, buf + sizeof(buf) - p);
 }
 
 void TilesFramework::json_write_int(const string& name, int value)
@@ -2068,9 +2447,9 @@ void TilesFramework::json_write_bool(bool value)
     json_write_comma();
 
     if (value)
-        write_message("true");
+        m_msg_buf.append("true", 4);
     else
-        write_message("false");
+        m_msg_buf.append("false", 5);
 }
 
 void TilesFramework::json_write_bool(const string& name, bool value)
@@ -2085,7 +2464,7 @@ void TilesFramework::json_write_null()
 {
     json_write_comma();
 
-    write_message("null");
+    m_msg_buf.append("null", 4);
 }
 
 void TilesFramework::json_write_null(const string& name)
@@ -2100,9 +2479,9 @@ void TilesFramework::json_write_string(const string& value)
 {
     json_write_comma();
 
-    write_message("\"");
+    m_msg_buf.push_back('"');
     write_message_escaped(value);
-    write_message("\"");
+    m_msg_buf.push_back('"');
 }
 
 void TilesFramework::json_write_string(const string& name, const string& value)
@@ -7,6 +7,7 @@
 #define TILEWEB_H
 
 #include <bitset>
+#include <deque>
 #include <map>
 #include <sys/un.h>
 
@@ -207,11 +208,34 @@ protected:
     int m_sock;
     int m_max_msg_size;
     string m_msg_buf;
-    vector<sockaddr_un> m_dest_addrs;
+
+    // Output is queued once and each destination works through the queue
+    // at its own pace, so a slow reader can't hold up the game.
+    struct OutputFragment
+    {
+        string data;
+        bool ends_message;
+    };
+    deque<OutputFragment> m_out_queue;
+    unsigned int m_out_seq; // sequence number of m_out_queue.front()
+    size_t m_out_bytes;
+
+    struct OutputDest
+    {
+        sockaddr_un addr;
+        unsigned int next; // sequence number of the next fragment to send
+        bool mid_message;
+        bool needs_resync;
+    };
+    vector<OutputDest> m_dest_addrs;
+    bool m_need_resync;
 
     bool m_controlled_from_web;
     bool m_need_flush;
 
+    void _vwrite_message(const char *format, va_list argp);
+    void _send_output();
+    void _trim_output();
     void _await_connection();
     wint_t _handle_control_message(sockaddr_un addr, string data);
     wint_t _receive_control_message();
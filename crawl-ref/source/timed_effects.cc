@@ -7,6 +7,8 @@
 
 #include "timed_effects.h"
 
+#include <chrono>
+
 #include "abyss.h"
 #include "act-iter.h"
 #include "areas.h"
@@ -1291,18 +1293,18 @@ void monster::timeout_enchantments(int levels)
         return;
 
     const mon_enchant_list ec = enchantments;
-    for (auto &entry : ec)
+    for (const mon_enchant &entry : ec)
     {
-        switch (entry.first)
+        switch (entry.ench)
         {
         case ENCH_WITHDRAWN:
             if (hit_points >= (max_hit_points - max_hit_points / 4)
                 && !one_chance_in(3))
             {
-                del_ench(entry.first);
+                del_ench(entry.ench);
                 break;
             }
-            lose_ench_levels(entry.second, levels);
+            lose_ench_levels(entry, levels);
             break;
 
         case ENCH_POISON: case ENCH_CORONA:
@@ -1322,18 +1324,17 @@ void monster::timeout_enchantments(int levels)
         case ENCH_BLACK_MARK: case ENCH_SAP_MAGIC: case ENCH_NEUTRAL_BRIBED:
         case ENCH_FRIENDLY_BRIBED: case ENCH_CORROSION: case ENCH_GOLD_LUST:
         case ENCH_RESISTANCE: case ENCH_HEXED:
-            lose_ench_levels(entry.second, levels);
+            lose_ench_levels(entry, levels);
             break;
 
         case ENCH_SLOW:
             if (torpor_slowed())
             {
-                lose_ench_levels(entry.second,
-                                 min(levels, entry.second.degree - 1));
+                lose_ench_levels(entry, min(levels, entry.degree - 1));
             }
             else
             {
-                lose_ench_levels(entry.second, levels);
+                lose_ench_levels(entry, levels);
                 if (props.exists(TORPOR_SLOWED_KEY))
                     props.erase(TORPOR_SLOWED_KEY);
             }
@@ -1341,7 +1342,7 @@ void monster::timeout_enchantments(int levels)
 
         case ENCH_INVIS:
             if (!mons_class_flag(type, M_INVIS))
-                lose_ench_levels(entry.second, levels);
+                lose_ench_levels(entry, levels);
             break;
 
         case ENCH_INSANE:
@@ -1349,22 +1350,22 @@ void monster::timeout_enchantments(int levels)
         case ENCH_INNER_FLAME:
         case ENCH_ROLLING:
         case ENCH_MERFOLK_AVATAR_SONG:
-            del_ench(entry.first);
+            del_ench(entry.ench);
             break;
 
         case ENCH_FATIGUE:
-            del_ench(entry.first);
+            del_ench(entry.ench);
             del_ench(ENCH_SLOW);
             break;
 
         case ENCH_TP:
             teleport(true);
-            del_ench(entry.first);
+            del_ench(entry.ench);
             break;
 
         case ENCH_CONFUSION:
             if (!mons_class_flag(type, M_CONFUSED))
-                del_ench(entry.first);
+                del_ench(entry.ench);
             // That triggered a behaviour_event, which could have made a
             // pacified monster leave the level.
             if (alive() && !is_stationary())
@@ -1372,20 +1373,20 @@ void monster::timeout_enchantments(int levels)
             break;
 
         case ENCH_HELD:
-            del_ench(entry.first);
+            del_ench(entry.ench);
             break;
 
         case ENCH_TIDE:
         {
             const int actdur = speed_to_duration(speed) * levels;
-            lose_ench_duration(entry.first, actdur);
+            lose_ench_duration(entry.ench, actdur);
             break;
         }
 
         case ENCH_SLOWLY_DYING:
         {
             const int actdur = speed_to_duration(speed) * levels;
-            if (lose_ench_duration(entry.first, actdur))
+            if (lose_ench_duration(entry.ench, actdur))
                 monster_die(this, KILL_MISC, NON_MONSTER, true);
             break;
         }
@@ -1399,9 +1400,93 @@ void monster::timeout_enchantments(int levels)
     }
 }
 
+/// Reports how long each phase of catching up a level took.
+class catchup_timer
+{
+public:
+    catchup_timer() : start(chrono::steady_clock::now()) { }
+
+    void lap(const char *phase)
+    {
+        const auto now = chrono::steady_clock::now();
+        dprf("catch-up %s: %d us", phase,
+             (int) chrono::duration_cast<chrono::microseconds>(now - start)
+                   .count());
+        start = now;
+    }
+
+private:
+    chrono::steady_clock::time_point start;
+};
+
+static void _recharge_rod(item_def &rod, int aut, bool in_inv);
+
+/**
+ * Rot floor items and recharge floor rods, in a single pass over mitm.
+ *
+ * @param elapsedTime   How long the player was away, in aut.
+ */
+static void _catchup_floor_items(int elapsedTime)
+{
+    const int turns = elapsedTime / 10;
+    const int rot_time = elapsedTime / ROT_TIME_FACTOR;
+
+    for (int i = 0; i < MAX_ITEMS; ++i)
+    {
+        item_def &item = mitm[i];
+        if (!item.defined())
+            continue;
+
+        if (item.base_type == OBJ_RODS)
+            _recharge_rod(item, turns, false);
+        else if (elapsedTime > 0)
+            rot_floor_item(i, rot_time);
+    }
+}
+
+/**
+ * Catch up a single monster for the time the player was away.
+ *
+ * @param mon       The monster.
+ * @param turns     The number of offlevel player turns to simulate.
+ */
+static void _catchup_monster(monster &mon, int turns)
+{
+    // Pacified monsters often leave the level now.
+    if (mon.pacified() && turns > random2(40) + 21)
+    {
+        make_mons_leave_level(&mon);
+        return;
+    }
+
+    // Following monsters don't get movement.
+    if (mon.flags & MF_JUST_SUMMONED)
+        return;
+
+    // XXX: Allow some spellcasting (like Healing and Teleport)? - bwr
+    // const bool healthy = (mon.hit_points * 2 > mon.max_hit_points);
+
+    mon.heal(div_rand_round(turns * mon.off_level_regen_rate(), 100));
+
+    // Handle nets specially to remove the trapping property of the net.
+    if (mon.caught())
+        mon.del_ench(ENCH_HELD, true);
+
+    _catchup_monster_moves(&mon, turns);
+
+    mon.foe_memory = max(mon.foe_memory - turns, 0);
+
+    if (turns >= 10 && mon.alive())
+        mon.timeout_enchantments(turns / 10);
+}
+
 /**
  * Update the level upon the player's return.
  *
+ * This runs as a series of phases, each making one pass over what it
+ * touches: floor items, terrain timers, then the monsters that were on
+ * the level when catch-up began.
+ *
  * @param elapsedTime how long the player was away.
  */
 void update_level(int elapsedTime)
@@ -1409,17 +1494,15 @@ void update_level(int elapsedTime)
     ASSERT(!crawl_state.game_is_arena());
 
     const int turns = elapsedTime / 10;
-
-#ifdef DEBUG_DIAGNOSTICS
-    int mons_total = 0;
+    catchup_timer timer;
 
     dprf("turns: %d", turns);
-#endif
 
-    rot_floor_items(elapsedTime);
+    _catchup_floor_items(elapsedTime);
+    timer.lap("floor items");
+
     shoals_apply_tides(turns, true, turns < 5);
     timeout_tombs(turns);
-    recharge_rods(turns, true);
 
     if (env.sanctuary_time)
     {
@@ -1431,44 +1514,21 @@ void update_level(int elapsedTime)
 
     dungeon_events.fire_event(
         dgn_event(DET_TURN_ELAPSED, coord_def(0, 0), turns * 10));
+    timer.lap("terrain and markers");
 
+    // Gather the monsters once; catching one up can kill or remove others,
+    // so each is checked again before it is handled.
+    vector<monster *> mons;
+    mons.reserve(MAX_MONSTERS);
     for (monster_iterator mi; mi; ++mi)
-    {
-#ifdef DEBUG_DIAGNOSTICS
-        mons_total++;
-#endif
-
-        // Pacified monsters often leave the level now.
-        if (mi->pacified() && turns > random2(40) + 21)
-        {
-            make_mons_leave_level(*mi);
-            continue;
-        }
-
-        // Following monsters don't get movement.
-        if (mi->flags & MF_JUST_SUMMONED)
-            continue;
+        mons.push_back(*mi);
 
-        // XXX: Allow some spellcasting (like Healing and Teleport)? - bwr
-        // const bool healthy = (mi->hit_points * 2 > mi->max_hit_points);
+    for (monster *mon : mons)
+        if (mon->alive())
+            _catchup_monster(*mon, turns);
 
-        mi->heal(div_rand_round(turns * mi->off_level_regen_rate(), 100));
-
-        // Handle nets specially to remove the trapping property of the net.
-        if (mi->caught())
-            mi->del_ench(ENCH_HELD, true);
-
-        _catchup_monster_moves(*mi, turns);
-
-        mi->foe_memory = max(mi->foe_memory - turns, 0);
-
-        if (turns >= 10 && mi->alive())
-            mi->timeout_enchantments(turns / 10);
-    }
-
-#ifdef DEBUG_DIAGNOSTICS
-    dprf("total monsters on level = %d", mons_total);
-#endif
+    dprf("total monsters on level = %d", (int) mons.size());
+    timer.lap("monsters");
 
     delete_all_clouds();
 }
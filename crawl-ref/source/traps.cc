@@ -1761,6 +1761,7 @@ void handle_items_on_shaft(const coord_def& pos, bool open_shaft)
             mitm[o].base_type = OBJ_UNASSIGNED;
             mitm[o].quantity = 0;
             mitm[o].props.clear();
+            mitm_slot_freed(o);
         }
 
         o = next;
@@ -623,6 +623,107 @@ static void _start_running()
 void stop_running()
 {
     you.running.stop();
+    forget_travel_route();
+}
+
+// The route the last travel flood found back from its destination. Rather
+// than flood again every step, travel follows it for as long as the map
+// around it stays unchanged.
+struct travel_route
+{
+    bool valid;
+    level_id level;
+    coord_def dest;
+    travel_route_grid_t next;
+    // Squares on or beside the route with passable terrain that were
+    // unsafe when it was found (clouds, monsters and the like). A shorter
+    // way may open up once any of them is safe again.
+    vector<coord_def> obstacles;
+};
+
+static travel_route last_route;
+
+void forget_travel_route()
+{
+    last_route.valid = false;
+}
+
+// The player learned something about the terrain at c. Only a change in or
+// beside the flooded area can make a shorter way than the remembered route.
+void travel_map_changed(const coord_def &c)
+{
+    if (!last_route.valid)
+        return;
+
+    for (adjacent_iterator ai(c, false); ai; ++ai)
+        if (map_bounds(*ai) && !last_route.next(*ai).origin())
+        {
+            forget_travel_route();
+            return;
+        }
+}
+
+// Remember what the route from youpos had to go around without the
+// terrain forcing it to.
+static void _note_route_obstacles(const coord_def &youpos)
+{
+    last_route.obstacles.clear();
+    int length = 0;
+    for (coord_def c = youpos; !c.origin() && ++length <= GXM * GYM;
+         c = c == last_route.dest ? coord_def() : last_route.next(c))
+    {
+        for (adjacent_iterator ai(c, false); ai; ++ai)
+        {
+            if (in_bounds(*ai) && env.map_knowledge(*ai).known()
+                && feat_is_traversable_now(env.map_knowledge(*ai).feat())
+                && !_is_travelsafe_square(*ai))
+            {
+                last_route.obstacles.push_back(*ai);
+            }
+        }
+    }
+    sort(last_route.obstacles.begin(), last_route.obstacles.end());
+    last_route.obstacles.erase(unique(last_route.obstacles.begin(),
+                                      last_route.obstacles.end()),
+                               last_route.obstacles.end());
+}
+
+// The next step along the remembered route from youpos, or the origin if
+// the route must be found again: when the map changed beside it, when it
+// is no longer safe, or when something it went around has cleared.
+static coord_def _travel_route_step(const coord_def &youpos)
+{
+    if (!last_route.valid
+        || last_route.dest != you.running.pos
+        || last_route.level != level_id::current())
+    {
+        return coord_def();
+    }
+
+    const coord_def step = last_route.next(youpos);
+    if (step.origin() || !_is_safe_move(step))
+        return coord_def();
+
+    unwind_bool slime_wall_check(g_Slime_Wall_Check,
+                                 !actor_slime_wall_immune(&you));
+    unwind_slime_wall_precomputer slime_neighbours(g_Slime_Wall_Check);
+
+    // Clouds, remembered monsters and flight can make a square unsafe
+    // without the terrain changing, so check the rest of the way.
+    int length = 0;
+    for (coord_def c = step; c != last_route.dest; c = last_route.next(c))
+    {
+        if (c.origin() || !_is_travelsafe_square(c) || ++length > GXM * GYM)
+            return coord_def();
+    }
+    if (!_is_travelsafe_square(last_route.dest))
+        return coord_def();
+
+    for (const coord_def &c : last_route.obstacles)
+        if (_is_travelsafe_square(c))
+            return coord_def();
+
+    return step;
 }
 
 static bool _is_valid_explore_target(const coord_def& where)
@@ -1137,7 +1238,8 @@ travel_pathfind::travel_pathfind()
       ignore_danger(false), annotate_map(false), ls(nullptr),
       need_for_greed(false), autopickup(false),
       unexplored_place(), greedy_place(), unexplored_dist(0), greedy_dist(0),
-      refdist(nullptr), reseed_points(), features(nullptr), unreachables(),
+      refdist(nullptr), reseed_points(), features(nullptr), route(nullptr),
+      unreachables(),
       point_distance(travel_point_distance), points(0), next_iter_points(0),
       traveled_distance(0), circ_index(0)
 {
@@ -1198,6 +1300,11 @@ void travel_pathfind::set_feature_vector(vector<coord_def> *feats)
     }
 }
 
+void travel_pathfind::set_route_grid(travel_route_grid_t *grid)
+{
+    route = grid;
+}
+
 const coord_def travel_pathfind::travel_move() const
 {
     return next_travel_move;
@@ -1649,6 +1756,8 @@ bool travel_pathfind::path_flood(const coord_def &c, const coord_def &dc)
         // iteration
         circumference[!circ_index][next_iter_points++] = dc;
         point_distance[dc.x][dc.y] = traveled_distance;
+        if (route)
+            (*route)(dc) = c;
 
         // Negative distances here so that show_map can colour
         // the map differently for these squares.
@@ -1756,7 +1865,29 @@ void find_travel_pos(const coord_def& youpos,
     run_mode_type rmode = (move_x && move_y) ? RMODE_TRAVEL
                                              : RMODE_NOT_RUNNING;
 
-    coord_def dest = tp.pathfind(rmode, false);
+    coord_def dest;
+    if (rmode == RMODE_TRAVEL)
+    {
+        dest = _travel_route_step(youpos);
+        if (dest.origin())
+        {
+            forget_travel_route();
+            last_route.next.init(coord_def());
+            tp.set_route_grid(&last_route.next);
+        }
+    }
+
+    if (dest.origin())
+    {
+        dest = tp.pathfind(rmode, false);
+        if (rmode == RMODE_TRAVEL && !dest.origin())
+        {
+            last_route.valid = true;
+            last_route.level = level_id::current();
+            last_route.dest = you.running.pos;
+            _note_route_obstacles(youpos);
+        }
+    }
     if (dest.origin())
         dest = tp.pathfind(rmode, true);
     coord_def new_dest = dest;
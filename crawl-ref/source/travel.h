@@ -56,6 +56,8 @@ enum run_mode_type
 void stop_running();
 void travel_init_load_level();
 void travel_init_new_level();
+void forget_travel_route();
+void travel_map_changed(const coord_def &c);
 
 uint8_t is_waypoint(const coord_def &p);
 command_type direction_to_command(int x, int y);
@@ -144,6 +146,9 @@ const int PD_CLOUD = -20101;
  * *********************************************************************** */
 extern travel_distance_grid_t travel_point_distance;
 
+// For each square a travel flood reached, the square it was reached from.
+typedef FixedArray<coord_def, GXM, GYM> travel_route_grid_t;
+
 enum explore_stop_type
 {
     ES_NONE                      = 0x0000,
@@ -465,6 +470,10 @@ public:
     // Set feature vector to use; if non-nullptr, also sets annotate_map to true.
     void set_feature_vector(vector<coord_def> *features);
 
+    // Record where each square was reached from. For travel, which floods
+    // from the destination, that is the next step towards it.
+    void set_route_grid(travel_route_grid_t *grid);
+
     // Extract features without pathfinding
     void get_features();
 
@@ -556,6 +565,8 @@ protected:
 
     vector<coord_def> *features;
 
+    travel_route_grid_t *route;
+
     // List of unexplored and unreachable points.
     set<coord_def> unreachables;
 
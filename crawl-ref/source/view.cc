@@ -8,6 +8,7 @@
 #include "view.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <memory>
@@ -68,6 +69,7 @@
 #include "traps.h"
 #include "travel.h"
 #include "unicode.h"
+#include "unwind.h"
 #include "viewchar.h"
 #include "viewmap.h"
 #include "xom.h"
@@ -1285,6 +1287,42 @@ void run_animation(animation_type anim, use_animation_type type, bool cleanup)
     }
 }
 
+// When the view was last drawn, and whether a frame has been left undrawn
+// since then because of Options.runrest_max_fps.
+static chrono::steady_clock::time_point _last_frame_time;
+static bool _frame_skipped = false;
+static bool _forcing_frame = false;
+#ifdef DEBUG_DIAGNOSTICS
+static int _run_frames_drawn = 0;
+static int _run_frames_skipped = 0;
+#endif
+
+/**
+ * Is this step of a run, rest, travel or explore too soon after the last
+ * drawn frame to be drawn itself? Other multi-turn delays aren't capped.
+ */
+bool run_frame_capped()
+{
+    if (!you.running || Options.runrest_max_fps <= 0 || _forcing_frame)
+        return false;
+
+    return chrono::steady_clock::now() - _last_frame_time
+           < chrono::milliseconds(1000 / Options.runrest_max_fps);
+}
+
+/**
+ * Draw the frame run_frame_capped() last held back, if any, so that
+ * what the player is asked to look at is up to date.
+ */
+void redraw_skipped_view()
+{
+    if (!_frame_skipped)
+        return;
+
+    unwind_bool forcing(_forcing_frame, true);
+    viewwindow(false);
+}
+
 /**
  * Draws the main window using the character set returned
  * by get_show_glyph().
@@ -1341,7 +1379,25 @@ void viewwindow(bool show_updates, bool tiles_only, animation *a)
     bool run_dont_draw = you.running && Options.travel_delay < 0
                 && (!you.running.is_explore() || Options.explore_delay < 0);
 
-    if (run_dont_draw || you.asleep())
+#ifdef DEBUG_DIAGNOSTICS
+    if (!you.running && (_run_frames_drawn || _run_frames_skipped))
+    {
+        dprf("Automated movement drew %d frames and skipped %d.",
+             _run_frames_drawn, _run_frames_skipped);
+        _run_frames_drawn = _run_frames_skipped = 0;
+    }
+#endif
+
+    const bool capped = !a && run_frame_capped();
+    if (capped)
+    {
+        _frame_skipped = true;
+#ifdef DEBUG_DIAGNOSTICS
+        _run_frames_skipped++;
+#endif
+    }
+
+    if (run_dont_draw || capped || you.asleep())
     {
         // Reset env.show if we munged it.
         if (_layers != LAYERS_ALL)
@@ -1349,6 +1405,13 @@ void viewwindow(bool show_updates, bool tiles_only, animation *a)
         return;
     }
 
+    _last_frame_time = chrono::steady_clock::now();
+    _frame_skipped = false;
+#ifdef DEBUG_DIAGNOSTICS
+    if (you.running)
+        _run_frames_drawn++;
+#endif
+
     cursor_control cs(false);
 
     int flash_colour = you.flash_colour;
@@ -66,6 +66,8 @@ public:
 
 void run_animation(animation_type anim, use_animation_type type,
                    bool cleanup = true);
+bool run_frame_capped();
+void redraw_skipped_view();
 void viewwindow(bool show_updates = true, bool tiles_only = false,
                 animation *a = nullptr);
 void draw_cell(screen_cell_t *cell, const coord_def &gc,
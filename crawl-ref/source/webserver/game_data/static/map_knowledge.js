@@ -207,9 +207,144 @@ define(["jquery", "./enums", "./util"], function ($, enums, util) {
         clean_monster_table();
     };
 
+    // Field order of packed cells; see packed_cell_field in tileweb.cc.
+    var packed_fields = [
+        "f", "mf", "g", "col", "fg", "bg", "cloud",
+        "bloody", "old_blood", "silenced", "halo", "moldy", "glowing_mold",
+        "sanctuary", "liquefied", "orb_glow", "quad_glow", "disjunct",
+        "mangrove_water", "blood_rotation", "travel_trail", "heat_aura",
+        "flv", "ov"
+    ];
+    var packed_bools = {
+        bloody: true, old_blood: true, silenced: true, moldy: true,
+        glowing_mold: true, sanctuary: true, liquefied: true,
+        quad_glow: true, disjunct: true, mangrove_water: true
+    };
+
+    function unpack_cells(packed)
+    {
+        var bytes = atob(packed.cells);
+        var pos = 0;
+        var tiles = [];
+
+        function read_uint()
+        {
+            var v = 0, shift = 0, b;
+            do
+            {
+                b = bytes.charCodeAt(pos++);
+                v += (b & 0x7F) * Math.pow(2, shift);
+                shift += 7;
+            } while (b & 0x80);
+            return v;
+        }
+
+        function read_int()
+        {
+            var v = read_uint();
+            return (v % 2) ? -(v + 1) / 2 : v / 2;
+        }
+
+        function read_tile()
+        {
+            var v = read_uint();
+            if (v % 2)
+                return tiles[(v - 1) / 2];
+            var lo = read_uint(), hi = read_uint();
+            var t = hi == 0 ? lo | 0 : [lo | 0, hi | 0];
+            tiles.push(t);
+            return t;
+        }
+
+        function read_glyph()
+        {
+            var c = read_uint();
+            if (c == 0)
+                return "";
+            if (c < 0x10000)
+                return String.fromCharCode(c);
+            c -= 0x10000;
+            return String.fromCharCode(0xD800 + (c >> 10),
+                                       0xDC00 + (c & 0x3FF));
+        }
+
+        var cells = [];
+        var index = -1;
+        while (pos < bytes.length)
+        {
+            index += read_uint() + 1;
+            var fields = read_uint();
+            var cell = {
+                x: index % packed.w - packed.ox,
+                y: Math.floor(index / packed.w) - packed.oy
+            };
+            var t = null;
+
+            for (var i = 0; i < packed_fields.length; ++i)
+            {
+                if (!(fields & (1 << i)))
+                    continue;
+
+                var name = packed_fields[i];
+                if (name == "f" || name == "mf" || name == "col")
+                {
+                    cell[name] = read_int();
+                    continue;
+                }
+                if (name == "g")
+                {
+                    cell.g = read_glyph();
+                    continue;
+                }
+
+                t = t || {};
+                if (name == "fg")
+                {
+                    t.fg = read_tile();
+                    var base = read_uint();
+                    if (base)
+                        t.base = base - 1;
+                    t.doll = null;
+                    t.mcache = null;
+                }
+                else if (name == "bg" || name == "cloud")
+                    t[name] = read_tile();
+                else if (name == "flv")
+                {
+                    t.flv = { f: read_int() };
+                    var s = read_int();
+                    if (s)
+                        t.flv.s = s;
+                }
+                else if (name == "ov")
+                {
+                    var count = read_uint();
+                    t.ov = [];
+                    for (var j = 0; j < count; ++j)
+                        t.ov.push(read_int());
+                }
+                else if (packed_bools[name])
+                    t[name] = read_uint() != 0;
+                else
+                    t[name] = read_int();
+            }
+
+            if (t)
+                cell.t = t;
+            cells.push(cell);
+        }
+        return cells;
+    }
+
+    function merge_packed(packed)
+    {
+        merge_diff(unpack_cells(packed));
+    }
+
     return {
         get: get,
         merge: merge_diff,
+        merge_packed: merge_packed,
         clear: clear,
         touch: touch,
         visible: visible,
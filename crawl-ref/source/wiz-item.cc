@@ -400,6 +400,8 @@ void wizard_tweak_object()
         if (is_art && keyin == 'c')
         {
             _tweak_randart(you.inv[item]);
+            // It might be worn.
+            you.artefacts_changed();
             continue;
         }
 